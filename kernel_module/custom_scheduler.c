@@ -16,6 +16,7 @@
 #include <linux/time.h>
 #include <linux/list.h>
 #include <linux/uaccess.h>
+#include <linux/math64.h>
 
 MODULE_LICENSE("GPL");
 MODULE_AUTHOR("CPU Scheduler Team");
@@ -94,6 +95,14 @@ static bool scheduler_running = false;
 static LIST_HEAD(all_processes);
 static atomic_t next_pid = ATOMIC_INIT(1);  /* FIXED: Use atomic for thread safety */
 
+/*
+ * Running sums kept current by set_state(), so update_statistics() never
+ * walks the process list. Times are in jiffies until reported.
+ */
+static unsigned long finished_wait_jiffies;   /* READY stretches already ended */
+static unsigned long ready_since_sum;         /* last_update_jiffies of READY processes */
+static unsigned long total_turnaround_ms;     /* terminated processes */
+
 /* Proc filesystem entry */
 static struct proc_dir_entry *proc_entry = NULL;
 
@@ -105,6 +114,7 @@ static void update_statistics(void);
 static void enqueue_process(struct custom_pcb *proc);
 static struct custom_pcb *dequeue_process(void);
 static void check_waiting_processes(void);
+static void set_state(struct custom_pcb *proc, enum proc_state state);
 
 /*
  * Check for processes that should wake up from waiting
@@ -119,8 +129,7 @@ static void check_waiting_processes(void)
     list_for_each_entry(proc, &all_processes, global_list) {
         if (proc->state == PROC_WAITING) {
             if (time_after_eq(jiffies, proc->wakeup_time_jiffies)) {
-                proc->state = PROC_READY;
-                proc->last_update_jiffies = jiffies;
+                set_state(proc, PROC_READY);
                 enqueue_process(proc);
                 pr_info("custom_scheduler: Process %d (%s) woke up\n", proc->pid, proc->name);
             }
@@ -227,7 +236,7 @@ static struct custom_pcb *select_next_process(void)
     
     proc = dequeue_process();
     if (proc) {
-        proc->state = PROC_RUNNING;
+        set_state(proc, PROC_RUNNING);
         current_proc = proc;
         stats.context_switches++;
     }
@@ -238,51 +247,79 @@ static struct custom_pcb *select_next_process(void)
 }
 
 /*
- * Update scheduler statistics
+ * Per-state counter in stats, NULL for PROC_NEW
+ */
+static unsigned long *state_counter(enum proc_state state)
+{
+    switch (state) {
+    case PROC_READY:      return &stats.ready_processes;
+    case PROC_RUNNING:    return &stats.running_processes;
+    case PROC_WAITING:    return &stats.waiting_processes;
+    case PROC_TERMINATED: return &stats.terminated_processes;
+    default:              return NULL;
+    }
+}
+
+/*
+ * Wait time of one process, including its current stretch in READY
+ */
+static unsigned long proc_wait_ms(const struct custom_pcb *proc, unsigned long now)
+{
+    if (proc->state != PROC_READY)
+        return proc->wait_time_ms;
+    return proc->wait_time_ms + jiffies_to_msecs(now - proc->last_update_jiffies);
+}
+
+/*
+ * Move a process to a new state, keeping the state counters and the wait and
+ * turnaround sums current. Caller holds sched_lock.
+ */
+static void set_state(struct custom_pcb *proc, enum proc_state state)
+{
+    unsigned long now = jiffies;
+    unsigned long *counter = state_counter(proc->state);
+
+    if (counter)
+        (*counter)--;
+
+    /* Leaving READY ends a wait stretch; entering READY starts one (and the aging clock) */
+    if (proc->state == PROC_READY) {
+        proc->wait_time_ms += jiffies_to_msecs(now - proc->last_update_jiffies);
+        finished_wait_jiffies += now - proc->last_update_jiffies;
+        ready_since_sum -= proc->last_update_jiffies;
+    }
+    if (state == PROC_READY) {
+        proc->last_update_jiffies = now;
+        ready_since_sum += now;
+    }
+    if (state == PROC_TERMINATED) {
+        proc->turnaround_time_ms = jiffies_to_msecs(now - proc->arrival_time_jiffies);
+        total_turnaround_ms += proc->turnaround_time_ms;
+    }
+
+    proc->state = state;
+    counter = state_counter(state);
+    if (counter)
+        (*counter)++;
+}
+
+/*
+ * Update scheduler statistics: O(1), from the sums kept by set_state()
  */
 static void update_statistics(void)
 {
-    struct custom_pcb *proc;
     unsigned long flags;
-    unsigned long total_wait = 0, total_turnaround = 0;
-    int count = 0;
-    
+    unsigned long ready_wait_jiffies;
+    u64 total_wait_ms;
+
     spin_lock_irqsave(&sched_lock, flags);
-    
-    stats.running_processes = 0;
-    stats.ready_processes = 0;
-    stats.waiting_processes = 0;
-    stats.terminated_processes = 0;
-    
-    list_for_each_entry(proc, &all_processes, global_list) {
-        count++;
-        
-        switch (proc->state) {
-        case PROC_RUNNING:
-            stats.running_processes++;
-            break;
-        case PROC_READY:
-            stats.ready_processes++;
-            break;
-        case PROC_WAITING:
-            stats.waiting_processes++;
-            break;
-        case PROC_TERMINATED:
-            stats.terminated_processes++;
-            break;
-        default:
-            break;
-        }
-        
-        total_wait += proc->wait_time_ms;
-        total_turnaround += proc->turnaround_time_ms;
-    }
-    
-    stats.total_processes = count;
-    
-    if (count > 0) {
-        stats.avg_wait_time_ms = total_wait / count;
-        stats.avg_turnaround_time_ms = total_turnaround / count;
+
+    if (stats.total_processes > 0) {
+        /* Every READY process adds now - last_update; unsigned wrap-around cancels out */
+        ready_wait_jiffies = stats.ready_processes * jiffies - ready_since_sum;
+        total_wait_ms = div_u64((u64)(finished_wait_jiffies + ready_wait_jiffies) * MSEC_PER_SEC, HZ);
+        stats.avg_wait_time_ms = div64_ul(total_wait_ms, stats.total_processes);
+        stats.avg_turnaround_time_ms = total_turnaround_ms / stats.total_processes;
     }
     
     /* Calculate CPU utilization */
@@ -301,7 +338,6 @@ static void update_statistics(void)
 static int scheduler_thread_fn(void *data)
 {
     struct custom_pcb *proc;
-    struct custom_pcb *p;
     unsigned long flags;
     int exec_time;
     
@@ -328,13 +364,6 @@ static int scheduler_thread_fn(void *data)
             proc->remaining_time_ms -= exec_time;
             stats.total_cpu_time_ms += exec_time;
             
-            /* Update wait time for ready processes */
-            list_for_each_entry(p, &all_processes, global_list) {
-                if (p->state == PROC_READY) {
-                    p->wait_time_ms += exec_time;
-                }
-            }
-            
             /* Check if process was moved to WAITING state (e.g. by user command) */
             if (proc->state == PROC_WAITING) {
                 current_proc = NULL;
@@ -343,15 +372,13 @@ static int scheduler_thread_fn(void *data)
             }
             /* Check if process completed */
             else if (proc->remaining_time_ms <= 0) {
-                proc->state = PROC_TERMINATED;
-                proc->turnaround_time_ms = jiffies_to_msecs(jiffies - proc->arrival_time_jiffies);
+                set_state(proc, PROC_TERMINATED);
                 current_proc = NULL;
                 pr_info("custom_scheduler: Process %d (%s) terminated\n", 
                         proc->pid, proc->name);
             } else {
                 /* Preempt and re-enqueue */
-                proc->state = PROC_READY;
-                proc->last_update_jiffies = jiffies;
+                set_state(proc, PROC_READY);
                 enqueue_process(proc);
                 current_proc = NULL;
             }
@@ -378,6 +405,7 @@ static int sched_stats_show(struct seq_file *m, void *v)
 {
     struct custom_pcb *proc;
     unsigned long flags;
+    unsigned long now = jiffies;
     const char *state_str;
     
     seq_printf(m, "=== Custom CPU Scheduler Statistics ===\n\n");
@@ -422,7 +450,7 @@ static int sched_stats_show(struct seq_file *m, void *v)
             seq_printf(m, "%-6d %-20s %-10s %-8d %-8d %-10d %-10lu\n",
                        proc->pid, proc->name, state_str,
                        proc->base_priority, proc->effective_priority,
-                       proc->remaining_time_ms, proc->wait_time_ms);
+                       proc->remaining_time_ms, proc_wait_ms(proc, now));
         }
     }
     
@@ -489,10 +517,9 @@ static ssize_t sched_stats_write(struct file *file, const char __user *buffer,
         proc->effective_priority = priority;
         proc->burst_time_ms = burst_time;
         proc->remaining_time_ms = burst_time;
-        proc->state = PROC_READY;
+        proc->state = PROC_NEW;
         
         proc->arrival_time_jiffies = jiffies;
-        proc->last_update_jiffies = jiffies;
         proc->wait_time_ms = 0;
         proc->turnaround_time_ms = 0;
         
@@ -502,6 +529,8 @@ static ssize_t sched_stats_write(struct file *file, const char __user *buffer,
         /* Add to lists */
         spin_lock_irqsave(&sched_lock, flags);
         list_add_tail(&proc->global_list, &all_processes);
+        stats.total_processes++;
+        set_state(proc, PROC_READY);
         spin_unlock_irqrestore(&sched_lock, flags);
         
         enqueue_process(proc);
@@ -535,7 +564,7 @@ static ssize_t sched_stats_write(struct file *file, const char __user *buffer,
                         spin_unlock_irqrestore(&ready_q.lock, rq_flags);
                     }
                     
-                    p->state = PROC_WAITING;
+                    set_state(p, PROC_WAITING);
                     p->wakeup_time_jiffies = jiffies + msecs_to_jiffies(wait_ms);
                     pr_info("custom_scheduler: Process %d put to sleep for %d ms\n", pid, wait_ms);
                 } else {
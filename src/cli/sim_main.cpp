@@ -0,0 +1,348 @@
+#include "kernel/scheduler.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Headless batch simulator: runs a workload to completion on the virtual
+// clock and prints the resulting SchedulerStats.
+
+namespace {
+
+struct WorkloadEntry {
+    std::string name;
+    int priority = 5;
+    int burstTime = 500;
+    long long arrivalTime = 0;
+    RealTimeParams rt; // kind NONE for ordinary processes
+};
+
+struct Options {
+    int timeQuantumMs = 100;
+    int agingFactorSec = 5;
+    int randomCount = 0;
+    SchedulingPolicyType policy = SchedulingPolicyType::PRIORITY;
+    ReadyQueueType queueType = ReadyQueueType::BINARY_HEAP;
+    int priorityLevels = DEFAULT_PRIORITY_LEVELS;
+    int cpuCount = 1;
+    int mlfqLevels = 4;
+    int realTimeCount = 0;
+    int realTimeUtilization = 50;
+    unsigned seed = 1;
+    std::string workloadPath;
+};
+
+void printUsage(const char* argv0) {
+    std::cerr
+        << "Usage: " << argv0 << " [options] [workload-file | -]\n"
+        << "\n"
+        << "Options:\n"
+        << "  -q, --quantum MS   time quantum in ms (default 100)\n"
+        << "  -a, --aging SEC    aging factor in seconds (default 5)\n"
+        << "  -r, --random N     generate N random processes instead of reading a workload\n"
+        << "  -s, --seed N       seed for --random, the simulated I/O and lottery draws (default 1)\n"
+        << "  -p, --policy NAME  priority (default), fcfs, sjf, srtf, rr, cfs, mlfq, edf,\n"
+        << "                     stride or lottery\n"
+        << "      --queue TYPE   priority policy run queue: heap (default) or buckets\n"
+        << "      --levels N     number of priority levels, 0 = highest (default 11)\n"
+        << "      --mlfq-levels N  MLFQ queue count; level L gets quantum << L (default 4)\n"
+        << "  -c, --cpus N       number of simulated CPUs (default 1)\n"
+        << "      --rt N         add N random periodic real-time processes\n"
+        << "      --rt-util PCT  their total utilization, percent of one CPU (default 50)\n"
+        << "  -h, --help         show this help\n"
+        << "\n"
+        << "Workload format: one process per line, '#' starts a comment:\n"
+        << "  name priority burst_ms [arrival_ms]\n"
+        << "  periodic|sporadic name priority wcet_ms period_ms [deadline_ms [jobs [arrival_ms]]]\n";
+}
+
+bool parseInt(const char* text, long long& out) {
+    char* end = nullptr;
+    out = std::strtoll(text, &end, 10);
+    return end != text && *end == '\0';
+}
+
+bool parseArgs(int argc, char* argv[], Options& opts) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto needValue = [&](long long& value) {
+            if (i + 1 >= argc || !parseInt(argv[i + 1], value) || value < 0) {
+                std::cerr << "Invalid or missing value for " << arg << "\n";
+                return false;
+            }
+            ++i;
+            return true;
+        };
+
+        long long value = 0;
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            std::exit(0);
+        } else if (arg == "-q" || arg == "--quantum") {
+            if (!needValue(value) || value == 0) return false;
+            opts.timeQuantumMs = static_cast<int>(value);
+        } else if (arg == "-a" || arg == "--aging") {
+            if (!needValue(value) || value == 0) return false;
+            opts.agingFactorSec = static_cast<int>(value);
+        } else if (arg == "-r" || arg == "--random") {
+            if (!needValue(value)) return false;
+            opts.randomCount = static_cast<int>(value);
+        } else if (arg == "-s" || arg == "--seed") {
+            if (!needValue(value)) return false;
+            opts.seed = static_cast<unsigned>(value);
+        } else if (arg == "-p" || arg == "--policy") {
+            std::string name = i + 1 < argc ? argv[++i] : "";
+            if (!parsePolicyName(name, opts.policy)) {
+                std::cerr << "Unknown policy: " << name << "\n";
+                return false;
+            }
+        } else if (arg == "--queue") {
+            std::string type = i + 1 < argc ? argv[++i] : "";
+            if (type == "heap") {
+                opts.queueType = ReadyQueueType::BINARY_HEAP;
+            } else if (type == "buckets") {
+                opts.queueType = ReadyQueueType::PRIORITY_BUCKETS;
+            } else {
+                std::cerr << "Unknown queue type: " << type << "\n";
+                return false;
+            }
+        } else if (arg == "--levels") {
+            if (!needValue(value) || value == 0) return false;
+            opts.priorityLevels = static_cast<int>(value);
+        } else if (arg == "--mlfq-levels") {
+            if (!needValue(value) || value == 0) return false;
+            opts.mlfqLevels = static_cast<int>(value);
+        } else if (arg == "-c" || arg == "--cpus") {
+            if (!needValue(value) || value == 0) return false;
+            opts.cpuCount = static_cast<int>(value);
+        } else if (arg == "--rt") {
+            if (!needValue(value)) return false;
+            opts.realTimeCount = static_cast<int>(value);
+        } else if (arg == "--rt-util") {
+            if (!needValue(value)) return false;
+            opts.realTimeUtilization = static_cast<int>(value);
+        } else if (arg.size() > 1 && arg[0] == '-') {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return false;
+        } else {
+            opts.workloadPath = arg;
+        }
+    }
+    return true;
+}
+
+bool readWorkload(std::istream& in, int priorityLevels, std::vector<WorkloadEntry>& out) {
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        auto comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+
+        std::istringstream fields(line);
+        WorkloadEntry entry;
+        if (!(fields >> entry.name)) continue; // blank line
+
+        if (entry.name == "periodic" || entry.name == "sporadic") {
+            RealTimeParams& rt = entry.rt;
+            rt.kind = entry.name == "periodic" ? RealTimeKind::PERIODIC : RealTimeKind::SPORADIC;
+            if (!(fields >> entry.name >> entry.priority >> rt.wcetMs >> rt.periodMs)) {
+                std::cerr << "Line " << lineNo
+                          << ": expected '" << (rt.kind == RealTimeKind::PERIODIC ? "periodic" : "sporadic")
+                          << " name priority wcet_ms period_ms [deadline_ms [jobs [arrival_ms]]]'\n";
+                return false;
+            }
+            fields >> rt.deadlineMs >> rt.jobs >> entry.arrivalTime; // optional
+            if (entry.priority < 0 || entry.priority >= priorityLevels || rt.wcetMs <= 0 ||
+                rt.periodMs <= 0 || rt.deadlineMs < 0 || rt.jobs <= 0 || entry.arrivalTime < 0) {
+                std::cerr << "Line " << lineNo << ": priority must be 0-" << priorityLevels - 1
+                          << ", wcet, period and jobs > 0, deadline and arrival >= 0\n";
+                return false;
+            }
+            out.push_back(entry);
+            continue;
+        }
+
+        if (!(fields >> entry.priority >> entry.burstTime)) {
+            std::cerr << "Line " << lineNo << ": expected 'name priority burst_ms [arrival_ms]'\n";
+            return false;
+        }
+        fields >> entry.arrivalTime; // optional
+        if (entry.priority < 0 || entry.priority >= priorityLevels || entry.burstTime <= 0 || entry.arrivalTime < 0) {
+            std::cerr << "Line " << lineNo << ": priority must be 0-" << priorityLevels - 1
+                      << ", burst > 0, arrival >= 0\n";
+            return false;
+        }
+        out.push_back(entry);
+    }
+    return true;
+}
+
+void generateWorkload(int count, int priorityLevels, std::vector<WorkloadEntry>& out) {
+    long long arrival = 0;
+    for (int i = 0; i < count; ++i) {
+        WorkloadEntry entry;
+        entry.name = "Process_" + std::to_string(i + 1);
+        entry.priority = rand() % priorityLevels;
+        entry.burstTime = 100 + (rand() % 100) * 100; // same range as the GUI dialog
+        entry.arrivalTime = arrival;
+        arrival += rand() % 200;
+        out.push_back(entry);
+    }
+}
+
+// Periodic processes with implicit deadlines sharing utilizationPct of one CPU
+// equally, each releasing jobs for about ten seconds
+void generateRealTime(int count, int utilizationPct, int priorityLevels, std::vector<WorkloadEntry>& out) {
+    static const int PERIODS[] = {50, 100, 200, 500, 1000};
+    for (int i = 0; i < count; ++i) {
+        WorkloadEntry entry;
+        entry.name = "RealTime_" + std::to_string(i + 1);
+        entry.priority = rand() % priorityLevels;
+        entry.rt.kind = RealTimeKind::PERIODIC;
+        entry.rt.periodMs = PERIODS[rand() % 5];
+        entry.rt.wcetMs = std::max(1, entry.rt.periodMs * utilizationPct / (100 * count));
+        entry.rt.jobs = 10000 / entry.rt.periodMs;
+        out.push_back(entry);
+    }
+}
+
+void printStats(const SchedulerStats& stats, SchedulingPolicyType policy) {
+    std::printf("Policy:                 %s\n", policyName(policy));
+    std::printf("Total processes:        %d\n", stats.totalProcesses);
+    std::printf("Running:                %d\n", stats.runningProcesses);
+    std::printf("Ready:                  %d\n", stats.readyProcesses);
+    std::printf("Waiting:                %d\n", stats.waitingProcesses);
+    std::printf("Terminated:             %d\n", stats.terminatedProcesses);
+    std::printf("CPU utilization:        %.1f%%\n", stats.cpuUtilization);
+    std::printf("Context switches:       %d\n", stats.contextSwitchCount);
+    std::printf("Avg wait time:          %.2f ms\n", stats.averageWaitTime);
+    std::printf("Avg turnaround time:    %.2f ms\n", stats.averageTurnaroundTime);
+    std::printf("Simulated time:         %lld ms\n", stats.simulatedTimeMs);
+    std::printf("Events processed:       %lld\n", stats.eventsProcessed);
+    const LockStats& lock = stats.schedulerLock;
+    std::printf("Lock acquisitions:      %llu (%llu contended, %llu parked, avg hold %.0f ns)\n",
+                static_cast<unsigned long long>(lock.acquisitions),
+                static_cast<unsigned long long>(lock.contended),
+                static_cast<unsigned long long>(lock.parks), lock.averageHoldNs());
+
+    if (stats.cpuCount > 1) {
+        std::printf("CPUs:                   %d\n", stats.cpuCount);
+        std::printf("Migrations:             %d\n", stats.migrationCount);
+        std::printf("Load imbalance:         %d\n", stats.loadImbalance);
+        std::printf("\n  CPU   Util%%     Busy ms  Switches  Migrations\n");
+        for (size_t i = 0; i < stats.cpus.size(); ++i) {
+            const CpuStats& cpu = stats.cpus[i];
+            std::printf("  %3zu  %6.1f  %10lld  %8d  %10d\n", i, cpu.utilization,
+                        cpu.busyTimeMs, cpu.contextSwitches, cpu.migrations);
+        }
+    }
+
+    const LatencyStats& latency = stats.histograms->latency;
+    if (latency.turnaround.count() > 0) {
+        std::printf("\n  Latency ms        p50       p95       p99     p99.9       max      mean\n");
+        auto row = [](const char* name, const LatencyHistogram& h) {
+            std::printf("  %-12s %8lld  %8lld  %8lld  %8lld  %8lld  %8.1f\n", name, h.percentile(50),
+                        h.percentile(95), h.percentile(99), h.percentile(99.9), h.max(), h.mean());
+        };
+        row("wait", latency.wait);
+        row("response", latency.response);
+        row("turnaround", latency.turnaround);
+    }
+
+    const DeadlineStats& d = stats.deadlines;
+    if (d.jobsCompleted > 0 || d.rejected > 0) {
+        std::printf("\nReal-time jobs:         %lld\n", d.jobsCompleted);
+        std::printf("Rejected processes:     %d\n", d.rejected);
+        std::printf("Deadline misses:        %lld (%.1f%%)\n", d.deadlineMisses,
+                    d.jobsCompleted > 0 ? 100.0 * d.deadlineMisses / d.jobsCompleted : 0.0);
+        std::printf("Avg lateness:           %.2f ms\n", d.averageLatenessMs);
+        std::printf("Max lateness:           %lld ms\n", d.maxLatenessMs);
+        static const char* BUCKETS[DeadlineStats::LATENESS_BUCKETS] = {
+            "on time", "< 10 ms", "< 100 ms", "< 1 s", ">= 1 s"};
+        std::printf("\n  Late by     Jobs\n");
+        for (int i = 0; i < DeadlineStats::LATENESS_BUCKETS; ++i) {
+            std::printf("  %-8s  %6lld\n", BUCKETS[i], d.latenessBuckets[i]);
+        }
+    }
+}
+
+// Runs on a BatchScheduler, so the policy is fixed at compile time and every
+// pick-next call is direct
+template <typename Policy>
+SchedulerStats runBatch(const Options& opts, const std::vector<WorkloadEntry>& workload) {
+    PolicyOptions policyOptions;
+    policyOptions.queueType = opts.queueType;
+    policyOptions.priorityLevels = opts.priorityLevels;
+    policyOptions.mlfqLevels = opts.mlfqLevels;
+    policyOptions.seed = opts.seed;
+
+    BatchScheduler<Policy> scheduler(policyOptions, opts.cpuCount);
+    scheduler.setTimeQuantum(opts.timeQuantumMs);
+    scheduler.setAgingFactor(opts.agingFactorSec);
+    scheduler.setRetiredHistoryLimit(0); // only the totals are printed
+
+    for (const auto& entry : workload) {
+        if (entry.rt.kind != RealTimeKind::NONE) {
+            if (scheduler.scheduleArrival(entry.name, entry.priority, entry.rt, entry.arrivalTime) < 0) {
+                std::cerr << "Not admitted: " << entry.name << "\n";
+            }
+        } else {
+            scheduler.scheduleArrival(entry.name, entry.priority, entry.burstTime, entry.arrivalTime);
+        }
+    }
+
+    scheduler.runToCompletion();
+    return scheduler.getStats();
+}
+
+SchedulerStats runWorkload(const Options& opts, const std::vector<WorkloadEntry>& workload) {
+    switch (opts.policy) {
+        case SchedulingPolicyType::FCFS:        return runBatch<FcfsPolicy>(opts, workload);
+        case SchedulingPolicyType::SJF:         return runBatch<SjfPolicy>(opts, workload);
+        case SchedulingPolicyType::SRTF:        return runBatch<SrtfPolicy>(opts, workload);
+        case SchedulingPolicyType::ROUND_ROBIN: return runBatch<RoundRobinPolicy>(opts, workload);
+        case SchedulingPolicyType::CFS:         return runBatch<CfsPolicy>(opts, workload);
+        case SchedulingPolicyType::MLFQ:        return runBatch<MlfqPolicy>(opts, workload);
+        case SchedulingPolicyType::EDF:         return runBatch<EdfPolicy>(opts, workload);
+        case SchedulingPolicyType::STRIDE:      return runBatch<StridePolicy>(opts, workload);
+        case SchedulingPolicyType::LOTTERY:     return runBatch<LotteryPolicy>(opts, workload);
+        case SchedulingPolicyType::PRIORITY:    break;
+    }
+    return runBatch<PriorityPolicy>(opts, workload);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opts;
+    if (!parseArgs(argc, argv, opts)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+    srand(opts.seed);
+
+    std::vector<WorkloadEntry> workload;
+    if (opts.randomCount > 0) {
+        generateWorkload(opts.randomCount, opts.priorityLevels, workload);
+    } else if (opts.workloadPath.empty() || opts.workloadPath == "-") {
+        if (!readWorkload(std::cin, opts.priorityLevels, workload)) return 1;
+    } else {
+        std::ifstream file(opts.workloadPath);
+        if (!file) {
+            std::cerr << "Cannot open workload file: " << opts.workloadPath << "\n";
+            return 1;
+        }
+        if (!readWorkload(file, opts.priorityLevels, workload)) return 1;
+    }
+
+    generateRealTime(opts.realTimeCount, opts.realTimeUtilization, opts.priorityLevels, workload);
+
+    printStats(runWorkload(opts, workload), opts.policy);
+    return 0;
+}
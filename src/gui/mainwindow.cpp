@@ -85,6 +85,20 @@ void MainWindow::setupUI() {
     agingFactorSpinBox_->setValue(5);
     configLayout->addWidget(agingFactorSpinBox_);
     
+    configLayout->addWidget(new QLabel("Policy:"));
+    policyComboBox_ = new QComboBox();
+    policyComboBox_->addItem("Priority + Aging", static_cast<int>(SchedulingPolicyType::PRIORITY));
+    policyComboBox_->addItem("FCFS", static_cast<int>(SchedulingPolicyType::FCFS));
+    policyComboBox_->addItem("SJF", static_cast<int>(SchedulingPolicyType::SJF));
+    policyComboBox_->addItem("SRTF", static_cast<int>(SchedulingPolicyType::SRTF));
+    policyComboBox_->addItem("Round-Robin", static_cast<int>(SchedulingPolicyType::ROUND_ROBIN));
+    policyComboBox_->addItem("CFS", static_cast<int>(SchedulingPolicyType::CFS));
+    policyComboBox_->addItem("MLFQ", static_cast<int>(SchedulingPolicyType::MLFQ));
+    policyComboBox_->addItem("EDF", static_cast<int>(SchedulingPolicyType::EDF));
+    policyComboBox_->addItem("Stride", static_cast<int>(SchedulingPolicyType::STRIDE));
+    policyComboBox_->addItem("Lottery", static_cast<int>(SchedulingPolicyType::LOTTERY));
+    configLayout->addWidget(policyComboBox_);
+    
     applyConfigButton_ = new QPushButton("Apply");
     configLayout->addWidget(applyConfigButton_);
     configLayout->addStretch();
@@ -148,7 +162,7 @@ void MainWindow::onPauseClicked() {
     
     disconnect(pauseButton_, &QPushButton::clicked, this, &MainWindow::onPauseClicked);
     connect(pauseButton_, &QPushButton::clicked, this, [this]() {
-        scheduler_->start();
+        scheduler_->resume();
         pauseButton_->setText("Pause");
         disconnect(pauseButton_, nullptr, this, nullptr);
         connect(pauseButton_, &QPushButton::clicked, this, &MainWindow::onPauseClicked);
@@ -193,10 +207,10 @@ void MainWindow::onAddProcessClicked() {
     if (!ok) return;
     
     // Create process
-    auto proc = scheduler_->createProcess(name.toStdString(), priority, burstTime);
+    int pid = scheduler_->createProcess(name.toStdString(), priority, burstTime);
     
     logMessage("Created process: " + name.toStdString() + 
-               " (PID=" + std::to_string(proc->getPid()) + 
+               " (PID=" + std::to_string(pid) + 
                ", Priority=" + std::to_string(priority) + 
                ", Burst=" + std::to_string(burstTime) + "ms)");
 }
@@ -209,20 +223,22 @@ void MainWindow::onKillProcessClicked() {
         return;
     }
     
-    scheduler_->terminateProcess(pid);
+    scheduler_->terminateProcessAsync(pid); // applied on the next tick; never waits for the lock
     logMessage("Terminated process PID=" + std::to_string(pid));
 }
 
 void MainWindow::onApplyConfigClicked() {
     int timeQuantum = timeQuantumSpinBox_->value();
     int agingFactor = agingFactorSpinBox_->value();
+    auto policy = static_cast<SchedulingPolicyType>(policyComboBox_->currentData().toInt());
     
     scheduler_->setTimeQuantum(timeQuantum);
     scheduler_->setAgingFactor(agingFactor);
+    scheduler_->setPolicy(policy);
     
     logMessage("Configuration updated: TimeQuantum=" + 
                std::to_string(timeQuantum) + "ms, AgingFactor=" + 
-               std::to_string(agingFactor) + "s");
+               std::to_string(agingFactor) + "s, Policy=" + policyName(policy));
 }
 
 void MainWindow::onUpdateTimer() {
@@ -232,14 +248,16 @@ void MainWindow::onUpdateTimer() {
 
 void MainWindow::updateProcessTable() {
     if (scheduler_) {
-        auto processes = scheduler_->getProcessList();
-        processTable_->updateProcessList(processes);
+        ProcessSnapshotView snapshot = scheduler_->getProcessSnapshot(); // read in place, no copy
+        processTable_->updateProcessList(snapshot->processes, scheduler_->getCurrentTime());
     }
 }
 
 void MainWindow::updateStatistics() {
-    if (scheduler_) {
+    // Nothing published since the last refresh: skip the copy and the relayout
+    if (scheduler_ && scheduler_->getStatsGeneration() != statsGeneration_) {
         auto stats = scheduler_->getStats();
+        statsGeneration_ = stats.generation;
         statsWidget_->updateStats(stats);
     }
 }
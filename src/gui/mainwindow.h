@@ -3,6 +3,7 @@
 #include <QMainWindow>
 #include <QPushButton>
 #include <QSpinBox>
+#include <QComboBox>
 #include <QTextEdit>
 #include <QTimer>
 #include <memory>
@@ -45,6 +46,7 @@ private:
     // Configuration
     QSpinBox* timeQuantumSpinBox_;
     QSpinBox* agingFactorSpinBox_;
+    QComboBox* policyComboBox_;
     QPushButton* applyConfigButton_;
     
     // Display widgets
@@ -57,4 +59,5 @@ private:
     
     // State tracking
     bool schedulerRunning_;
+    uint64_t statsGeneration_ = 0; // last stats shown
 };
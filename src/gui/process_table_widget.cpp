@@ -33,7 +33,7 @@ void ProcessTableWidget::setupTable() {
 }
 
 void ProcessTableWidget::updateProcessList(
-    const std::vector<std::shared_ptr<Process>>& processes) {
+    const std::vector<Process>& processes, long long now) {
     
     // Store currently selected PID to restore after update
     int selectedPid = getSelectedPid();
@@ -53,38 +53,38 @@ void ProcessTableWidget::updateProcessList(
         int row = static_cast<int>(i);
         
         // Check if this is the previously selected process
-        if (selectedPid >= 0 && proc->getPid() == selectedPid) {
+        if (selectedPid >= 0 && proc.getPid() == selectedPid) {
             rowToSelect = row;
         }
         
         // PID
         QTableWidgetItem* pidItem = new QTableWidgetItem(
-            QString::number(proc->getPid()));
+            QString::number(proc.getPid()));
         setItem(row, 0, pidItem);
         
         // Name
         QTableWidgetItem* nameItem = new QTableWidgetItem(
-            QString::fromStdString(proc->getName()));
+            QString::fromStdString(proc.getName()));
         setItem(row, 1, nameItem);
         
         // State
-        ProcessState state = proc->getState();
+        ProcessState state = proc.getState();
         QTableWidgetItem* stateItem = new QTableWidgetItem(getStateName(state));
         setItem(row, 2, stateItem);
         
         // Priority
         QTableWidgetItem* priorityItem = new QTableWidgetItem(
-            QString::number(proc->getPriority()));
+            QString::number(proc.getPriority()));
         setItem(row, 3, priorityItem);
         
         // Remaining Time
         QTableWidgetItem* remainingItem = new QTableWidgetItem(
-            QString::number(proc->getRemainingTime()));
+            QString::number(proc.getRemainingTime()));
         setItem(row, 4, remainingItem);
         
         // Wait Time
         QTableWidgetItem* waitItem = new QTableWidgetItem(
-            QString::number(proc->waitTime));
+            QString::number(proc.getWaitTime(now)));
         setItem(row, 5, waitItem);
         
         // Color code the row based on state
@@ -3,7 +3,6 @@
 #include <QWidget>
 #include <QTableWidget>
 #include <vector>
-#include <memory>
 #include "../kernel/process.h"
 
 class ProcessTableWidget : public QTableWidget {
@@ -13,7 +12,7 @@ public:
     explicit ProcessTableWidget(QWidget* parent = nullptr);
     ~ProcessTableWidget();
 
-    void updateProcessList(const std::vector<std::shared_ptr<Process>>& processes);
+    void updateProcessList(const std::vector<Process>& processes, long long now);
     int getSelectedPid() const;
 
 private:
@@ -2,6 +2,17 @@
 #include <QVBoxLayout>
 #include <QGroupBox>
 
+namespace {
+
+// "p50 / p95 / p99 / p99.9 ms", or "-" before anything finished
+QString percentiles(const LatencyHistogram& h) {
+    if (h.count() == 0) return "-";
+    return QString::number(h.percentile(50)) + " / " + QString::number(h.percentile(95)) + " / " +
+           QString::number(h.percentile(99)) + " / " + QString::number(h.percentile(99.9)) + " ms";
+}
+
+} // namespace
+
 StatsWidget::StatsWidget(QWidget* parent)
     : QWidget(parent) {
     
@@ -15,6 +26,13 @@ StatsWidget::StatsWidget(QWidget* parent)
     contextSwitchLabel_ = new QLabel("0");
     avgWaitTimeLabel_ = new QLabel("0.0 ms");
     avgTurnaroundTimeLabel_ = new QLabel("0.0 ms");
+    deadlineMissLabel_ = new QLabel("0 / 0");
+    latenessLabel_ = new QLabel("-");
+    waitPercentilesLabel_ = new QLabel("-");
+    responsePercentilesLabel_ = new QLabel("-");
+    turnaroundPercentilesLabel_ = new QLabel("-");
+    wakeupOvershootLabel_ = new QLabel("-");
+    lockContentionLabel_ = new QLabel("0 / 0");
     
     // Create form layout
     QFormLayout* formLayout = new QFormLayout();
@@ -27,6 +45,13 @@ StatsWidget::StatsWidget(QWidget* parent)
     formLayout->addRow("Context Switches:", contextSwitchLabel_);
     formLayout->addRow("Avg Wait Time:", avgWaitTimeLabel_);
     formLayout->addRow("Avg Turnaround:", avgTurnaroundTimeLabel_);
+    formLayout->addRow("Deadline Misses:", deadlineMissLabel_);
+    formLayout->addRow("Lateness (avg / max):", latenessLabel_);
+    formLayout->addRow("Wait p50/95/99/99.9:", waitPercentilesLabel_);
+    formLayout->addRow("Response p50/95/99/99.9:", responsePercentilesLabel_);
+    formLayout->addRow("Turnaround p50/95/99/99.9:", turnaroundPercentilesLabel_);
+    formLayout->addRow("Wake-up Overshoot p50/99/max:", wakeupOvershootLabel_);
+    formLayout->addRow("Lock Contended / Parked:", lockContentionLabel_);
     
     // Create group box
     QGroupBox* groupBox = new QGroupBox("Scheduler Statistics");
@@ -58,4 +83,26 @@ void StatsWidget::updateStats(const SchedulerStats& stats) {
     
     avgTurnaroundTimeLabel_->setText(
         QString::number(stats.averageTurnaroundTime, 'f', 2) + " ms");
+    
+    const DeadlineStats& d = stats.deadlines;
+    deadlineMissLabel_->setText(
+        QString::number(d.deadlineMisses) + " / " + QString::number(d.jobsCompleted) + " jobs");
+    latenessLabel_->setText(d.jobsCompleted == 0 ? QString("-") :
+        QString::number(d.averageLatenessMs, 'f', 1) + " / " + QString::number(d.maxLatenessMs) + " ms");
+    
+    const LatencyStats& latency = stats.histograms->latency;
+    waitPercentilesLabel_->setText(percentiles(latency.wait));
+    responsePercentilesLabel_->setText(percentiles(latency.response));
+    turnaroundPercentilesLabel_->setText(percentiles(latency.turnaround));
+    
+    const LatencyHistogram& overshoot = stats.histograms->wakeups.overshootUs;
+    wakeupOvershootLabel_->setText(overshoot.count() == 0 ? QString("-") :
+        QString::number(overshoot.percentile(50)) + " / " + QString::number(overshoot.percentile(99)) +
+        " / " + QString::number(overshoot.max()) + " us of " + QString::number(overshoot.count()));
+    
+    const LockStats& lock = stats.schedulerLock;
+    lockContentionLabel_->setText(
+        QString::number(lock.contended) + " / " + QString::number(lock.parks) + " of " +
+        QString::number(lock.acquisitions) + ", max hold " +
+        QString::number(lock.maxHoldNs / 1000.0, 'f', 1) + " us");
 }
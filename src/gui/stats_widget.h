@@ -24,4 +24,11 @@ private:
     QLabel* contextSwitchLabel_;
     QLabel* avgWaitTimeLabel_;
     QLabel* avgTurnaroundTimeLabel_;
+    QLabel* deadlineMissLabel_;
+    QLabel* latenessLabel_;
+    QLabel* waitPercentilesLabel_;
+    QLabel* responsePercentilesLabel_;
+    QLabel* turnaroundPercentilesLabel_;
+    QLabel* wakeupOvershootLabel_;
+    QLabel* lockContentionLabel_;
 };
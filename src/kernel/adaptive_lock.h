@@ -0,0 +1,145 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Contention counters of one AdaptiveLock
+struct LockStats {
+    uint64_t acquisitions = 0;
+    uint64_t contended = 0;  // acquisitions that found the lock held
+    uint64_t spins = 0;      // pause iterations spent waiting
+    uint64_t parks = 0;      // times a waiter slept in the kernel
+    // Hold times, sampled on one acquisition in HOLD_SAMPLE_INTERVAL
+    uint64_t holdSamples = 0;
+    uint64_t holdTimeNs = 0;
+    uint64_t maxHoldNs = 0;
+
+    double averageHoldNs() const { return holdSamples ? static_cast<double>(holdTimeNs) / holdSamples : 0.0; }
+};
+
+// Mutex that spins briefly with exponential backoff and then parks the
+// waiter on a futex (a yield loop elsewhere), so a long critical section on
+// one thread no longer burns a core on the other. The state word follows
+// Drepper's "Futexes Are Tricky": 0 free, 1 held, 2 held with sleepers, so an
+// uncontended lock/unlock pair is one CAS and one exchange. The counters are
+// only written by the holder, so they need no atomics; read them with the
+// lock held. Timing every hold would double the cost of an uncontended
+// acquisition, so hold times are sampled.
+class AdaptiveLock {
+public:
+    static constexpr int MAX_BACKOFF = 64; // pause iterations in the last spin round
+    static constexpr uint64_t HOLD_SAMPLE_INTERVAL = 8;
+
+    AdaptiveLock() = default;
+    AdaptiveLock(const AdaptiveLock&) = delete;
+    AdaptiveLock& operator=(const AdaptiveLock&) = delete;
+
+    void lock() {
+        uint32_t expected = FREE;
+        if (!state_.compare_exchange_strong(expected, HELD, std::memory_order_acquire,
+                                            std::memory_order_relaxed)) {
+            lockContended();
+        }
+        timed_ = stats_.acquisitions++ % HOLD_SAMPLE_INTERVAL == 0;
+        if (timed_) holdStart_ = std::chrono::steady_clock::now();
+    }
+
+    void unlock() {
+        if (timed_) {
+            auto held = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - holdStart_).count());
+            stats_.holdSamples++;
+            stats_.holdTimeNs += held;
+            if (held > stats_.maxHoldNs) stats_.maxHoldNs = held;
+        }
+
+        if (state_.exchange(FREE, std::memory_order_release) == PARKED) {
+            wake();
+        }
+    }
+
+    const LockStats& stats() const { return stats_; } // caller holds the lock
+
+private:
+    static constexpr uint32_t FREE = 0;
+    static constexpr uint32_t HELD = 1;
+    static constexpr uint32_t PARKED = 2; // held, and someone may be asleep
+
+    void lockContended() {
+        uint64_t spins = 0;
+        for (int backoff = 1; backoff <= MAX_BACKOFF; backoff <<= 1) {
+            for (int i = 0; i < backoff; ++i) relax();
+            spins += backoff;
+            uint32_t expected = FREE;
+            if (state_.load(std::memory_order_relaxed) == FREE &&
+                state_.compare_exchange_weak(expected, HELD, std::memory_order_acquire,
+                                             std::memory_order_relaxed)) {
+                count(spins, 0);
+                return;
+            }
+        }
+
+        // Taking the lock as PARKED makes our unlock wake the next sleeper
+        uint64_t parks = 0;
+        while (state_.exchange(PARKED, std::memory_order_acquire) != FREE) {
+            parks++;
+            park();
+        }
+        count(spins, parks);
+    }
+
+    void count(uint64_t spins, uint64_t parks) { // lock held from here
+        stats_.contended++;
+        stats_.spins += spins;
+        stats_.parks += parks;
+    }
+
+    static void relax() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        asm volatile("yield");
+#endif
+    }
+
+    void park() { // returns at once if the state is no longer PARKED
+#ifdef __linux__
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&state_), FUTEX_WAIT_PRIVATE, PARKED,
+                nullptr, nullptr, 0);
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    void wake() {
+#ifdef __linux__
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&state_), FUTEX_WAKE_PRIVATE, 1,
+                nullptr, nullptr, 0);
+#endif
+    }
+
+    std::atomic<uint32_t> state_{FREE};
+    LockStats stats_;
+    bool timed_ = false; // the current hold is sampled
+    std::chrono::steady_clock::time_point holdStart_;
+};
+
+// RAII guard for AdaptiveLock
+class LockGuard {
+public:
+    explicit LockGuard(AdaptiveLock& lock) : lock_(lock) { lock_.lock(); }
+    ~LockGuard() { lock_.unlock(); }
+    LockGuard(const LockGuard&) = delete;
+    LockGuard& operator=(const LockGuard&) = delete;
+
+private:
+    AdaptiveLock& lock_;
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Fenwick (binary indexed) tree over non-negative weights at dense indices.
+// add() and the weighted lookup find() are O(log n); the index space grows on
+// demand by doubling, with an O(n) rebuild. Not synchronized.
+class FenwickTree {
+public:
+    size_t size() const { return weight_.size(); } // indices covered
+    long long total() const { return total_; }
+    long long weight(size_t i) const { return i < weight_.size() ? weight_[i] : 0; }
+
+    void add(size_t i, long long delta) {
+        if (i >= weight_.size()) grow(i + 1);
+        weight_[i] += delta;
+        total_ += delta;
+        for (size_t k = i + 1; k <= tree_.size(); k += k & (~k + 1)) {
+            tree_[k - 1] += delta;
+        }
+    }
+
+    // Index i with prefix(i) <= target < prefix(i) + weight(i), where prefix(i)
+    // is the sum of the weights before i. Requires 0 <= target < total().
+    size_t find(long long target) const {
+        size_t pos = 0;
+        for (size_t step = tree_.size(); step > 0; step >>= 1) { // size is a power of two
+            if (tree_[pos + step - 1] <= target) {
+                pos += step;
+                target -= tree_[pos - 1];
+            }
+        }
+        return pos;
+    }
+
+private:
+    void grow(size_t count) {
+        size_t capacity = tree_.empty() ? 16 : tree_.size();
+        while (capacity < count) capacity *= 2;
+        weight_.resize(capacity, 0);
+        tree_.assign(weight_.begin(), weight_.end());
+        for (size_t k = 1; k <= capacity; ++k) {
+            size_t parent = k + (k & (~k + 1));
+            if (parent <= capacity) tree_[parent - 1] += tree_[k - 1];
+        }
+    }
+
+    std::vector<long long> weight_;
+    std::vector<long long> tree_; // tree_[k - 1] sums the weights in (k - lowbit(k), k]
+    long long total_ = 0;
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "process_table.h"
+#include <cstdint>
+#include <vector>
+
+// FIFO of process handles in a power-of-two ring buffer. Removal from the
+// middle is O(1): the entry's ticket is invalidated and pop() skips it later.
+// Each handle is queued at most once. Not synchronized.
+class FifoRing {
+public:
+    void push(ProcessHandle proc) { // no-op if already queued
+        if (proc >= ticket_.size()) ticket_.resize(proc + 1, 0);
+        if (ticket_[proc] != 0) return;
+        if (used_ == ring_.size()) grow();
+        uint32_t ticket = nextTicket_++;
+        if (nextTicket_ == 0) nextTicket_ = 1; // 0 means "not queued"
+        ring_[(head_ + used_) & (ring_.size() - 1)] = {proc, ticket};
+        ticket_[proc] = ticket;
+        ++used_;
+        ++live_;
+    }
+
+    ProcessHandle pop() { // INVALID_PROCESS when empty
+        while (used_ > 0) {
+            Entry entry = ring_[head_];
+            head_ = (head_ + 1) & (ring_.size() - 1);
+            --used_;
+            if (isLive(entry)) {
+                ticket_[entry.proc] = 0;
+                --live_;
+                return entry.proc;
+            }
+        }
+        return INVALID_PROCESS;
+    }
+
+    ProcessHandle front() {
+        while (used_ > 0 && !isLive(ring_[head_])) { // drop removed entries
+            head_ = (head_ + 1) & (ring_.size() - 1);
+            --used_;
+        }
+        return used_ > 0 ? ring_[head_].proc : INVALID_PROCESS;
+    }
+
+    bool remove(ProcessHandle proc) {
+        if (!contains(proc)) return false;
+        ticket_[proc] = 0; // the ring slot becomes garbage
+        --live_;
+        return true;
+    }
+
+    bool contains(ProcessHandle proc) const { return proc < ticket_.size() && ticket_[proc] != 0; }
+    bool empty() const { return live_ == 0; }
+    size_t size() const { return live_; }
+
+    // Live handles in FIFO order
+    template <typename F>
+    void forEach(F&& f) const {
+        for (size_t i = 0; i < used_; ++i) {
+            const Entry& entry = ring_[(head_ + i) & (ring_.size() - 1)];
+            if (isLive(entry)) f(entry.proc);
+        }
+    }
+
+private:
+    struct Entry {
+        ProcessHandle proc;
+        uint32_t ticket;
+    };
+
+    bool isLive(const Entry& entry) const { return ticket_[entry.proc] == entry.ticket; }
+
+    void grow() {
+        std::vector<Entry> bigger(ring_.empty() ? 16 : ring_.size() * 2);
+        size_t count = 0;
+        for (size_t i = 0; i < used_; ++i) { // compacts away removed entries
+            const Entry& entry = ring_[(head_ + i) & (ring_.size() - 1)];
+            if (isLive(entry)) bigger[count++] = entry;
+        }
+        ring_.swap(bigger);
+        head_ = 0;
+        used_ = count;
+    }
+
+    std::vector<Entry> ring_;
+    size_t head_ = 0;
+    size_t used_ = 0; // occupied slots, including removed entries
+    size_t live_ = 0;
+    std::vector<uint32_t> ticket_; // handle -> ticket of its queued entry, 0 if absent
+    uint32_t nextTicket_ = 1;
+};
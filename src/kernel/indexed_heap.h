@@ -0,0 +1,109 @@
+#pragma once
+
+#include "process_table.h"
+#include <cstdint>
+#include <vector>
+
+// Binary min-heap of process handles that tracks each handle's slot, so a
+// single entry can be removed or re-keyed in O(log n). Before(a, b) is true
+// when a should be dequeued before b. Not synchronized.
+template <typename Before>
+class IndexedHeap {
+public:
+    explicit IndexedHeap(Before before = Before()) : before_(before) {}
+
+    void push(ProcessHandle proc) { // no-op if already queued
+        if (proc >= position_.size()) position_.resize(proc + 1, NOT_QUEUED);
+        if (position_[proc] != NOT_QUEUED) return;
+        heap_.push_back(proc);
+        place(heap_.size() - 1);
+        siftUp(heap_.size() - 1);
+    }
+
+    ProcessHandle pop() { // INVALID_PROCESS when empty
+        if (heap_.empty()) return INVALID_PROCESS;
+        ProcessHandle top = heap_.front();
+        removeAt(0);
+        return top;
+    }
+
+    ProcessHandle top() const { return heap_.empty() ? INVALID_PROCESS : heap_.front(); }
+
+    bool remove(ProcessHandle proc) {
+        if (!contains(proc)) return false;
+        removeAt(position_[proc]);
+        return true;
+    }
+
+    // Restores order after proc's key changed
+    void update(ProcessHandle proc) {
+        if (!contains(proc)) return;
+        size_t index = position_[proc];
+        siftUp(index);
+        siftDown(position_[proc]);
+    }
+
+    bool contains(ProcessHandle proc) const {
+        return proc < position_.size() && position_[proc] != NOT_QUEUED;
+    }
+    bool empty() const { return heap_.empty(); }
+    size_t size() const { return heap_.size(); }
+    const std::vector<ProcessHandle>& items() const { return heap_; } // heap order
+
+    Before& before() { return before_; }
+
+    // Rebuilds the heap after every key changed at once
+    void rebuild() {
+        for (size_t i = heap_.size() / 2; i-- > 0;) siftDown(i);
+    }
+
+private:
+    static constexpr uint32_t NOT_QUEUED = UINT32_MAX;
+
+    void place(size_t index) { position_[heap_[index]] = static_cast<uint32_t>(index); }
+
+    void siftUp(size_t index) {
+        while (index > 0) {
+            size_t parent = (index - 1) / 2;
+            if (!before_(heap_[index], heap_[parent])) break;
+            swapNodes(index, parent);
+            index = parent;
+        }
+    }
+
+    void siftDown(size_t index) {
+        size_t count = heap_.size();
+        while (true) {
+            size_t best = index;
+            size_t left = 2 * index + 1, right = left + 1;
+            if (left < count && before_(heap_[left], heap_[best])) best = left;
+            if (right < count && before_(heap_[right], heap_[best])) best = right;
+            if (best == index) break;
+            swapNodes(index, best);
+            index = best;
+        }
+    }
+
+    void swapNodes(size_t a, size_t b) {
+        std::swap(heap_[a], heap_[b]);
+        place(a);
+        place(b);
+    }
+
+    void removeAt(size_t index) {
+        position_[heap_[index]] = NOT_QUEUED;
+        size_t last = heap_.size() - 1;
+        ProcessHandle moved = heap_[last];
+        heap_[index] = moved;
+        heap_.pop_back();
+        if (index < heap_.size()) { // the last entry filled the hole
+            place(index);
+            siftUp(index);
+            siftDown(position_[moved]);
+        }
+    }
+
+    Before before_;
+    std::vector<ProcessHandle> heap_;
+    std::vector<uint32_t> position_; // handle -> index in heap_, NOT_QUEUED if absent
+};
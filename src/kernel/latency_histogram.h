@@ -0,0 +1,91 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+// HDR-style histogram of non-negative latencies in ms. Values below SUB_COUNT
+// get a bucket each; above that, every power of two is split into SUB_COUNT
+// linear sub-buckets, so a reported value is within 1/SUB_COUNT (6.25%) of
+// the recorded one. record() is O(1), percentile() and merge() walk the fixed
+// bucket array. Values beyond MAX_VALUE are clamped. Not synchronized.
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BITS = 4;
+    static constexpr int SUB_COUNT = 1 << SUB_BITS;
+    static constexpr long long MAX_VALUE = (1LL << 31) - 1; // about 24 days
+    static constexpr int BUCKETS = (31 - SUB_BITS + 1) * SUB_COUNT;
+
+    void record(long long value) {
+        value = std::clamp(value, 0LL, MAX_VALUE);
+        counts_[bucketOf(value)]++;
+        if (count_ == 0 || value < min_) min_ = value;
+        if (value > max_) max_ = value;
+        count_++;
+        sum_ += value;
+    }
+
+    void merge(const LatencyHistogram& other) {
+        if (other.count_ == 0) return;
+        for (int i = 0; i < BUCKETS; ++i) counts_[i] += other.counts_[i];
+        min_ = count_ == 0 ? other.min_ : std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+        count_ += other.count_;
+        sum_ += other.sum_;
+    }
+
+    long long count() const { return count_; }
+    long long min() const { return min_; }
+    long long max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+
+    // Smallest value v such that at least p percent of the recordings are <= v,
+    // rounded up to its bucket's upper edge (never above max()). 0 when empty.
+    long long percentile(double p) const {
+        if (count_ == 0) return 0;
+        // p * count first: p / 100 is inexact, and ceil() would round up its error
+        auto rank = static_cast<long long>(std::ceil(std::clamp(p, 0.0, 100.0) * count_ / 100.0));
+        rank = std::clamp(rank, 1LL, count_);
+        long long seen = 0;
+        for (int i = 0; i < BUCKETS; ++i) {
+            seen += counts_[i];
+            if (seen >= rank) return std::clamp(upperEdge(i), min_, max_);
+        }
+        return max_;
+    }
+
+private:
+    static int bucketOf(long long value) {
+        if (value < SUB_COUNT) return static_cast<int>(value);
+        int magnitude = 63 - __builtin_clzll(static_cast<unsigned long long>(value));
+        int shift = magnitude - SUB_BITS;
+        return (shift + 1) * SUB_COUNT + static_cast<int>((value >> shift) - SUB_COUNT);
+    }
+
+    static long long upperEdge(int bucket) {
+        if (bucket < SUB_COUNT) return bucket;
+        int shift = bucket / SUB_COUNT - 1;
+        long long sub = bucket % SUB_COUNT + SUB_COUNT;
+        return ((sub + 1) << shift) - 1;
+    }
+
+    std::array<uint64_t, BUCKETS> counts_{};
+    long long count_ = 0;
+    long long sum_ = 0;
+    long long min_ = 0;
+    long long max_ = 0;
+};
+
+// Latency distributions of finished processes
+struct LatencyStats {
+    LatencyHistogram wait;       // total time spent READY
+    LatencyHistogram response;   // arrival to first dispatch, recorded at that dispatch
+    LatencyHistogram turnaround; // arrival to termination
+
+    void merge(const LatencyStats& other) {
+        wait.merge(other.wait);
+        response.merge(other.response);
+        turnaround.merge(other.turnaround);
+    }
+};
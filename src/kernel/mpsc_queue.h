@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+// Unbounded multi-producer/single-consumer FIFO (Vyukov's node queue).
+// push() is wait-free: one allocation, one exchange and one store, whatever
+// the number of producers. pop() must only be called by one thread at a time.
+// A producer is briefly between its exchange and its link store; pop() then
+// reports empty and the item appears on a later call.
+template <typename T>
+class MpscQueue {
+public:
+    MpscQueue() : head_(new Node), tail_(head_.load(std::memory_order_relaxed)) {}
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    ~MpscQueue() {
+        while (Node* node = tail_) {
+            tail_ = node->next.load(std::memory_order_relaxed);
+            delete node;
+        }
+    }
+
+    void push(T value) {
+        Node* node = new Node;
+        node->value.emplace(std::move(value));
+        Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    bool pop(T& out) {
+        Node* tail = tail_;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (!next) return false;
+        // next becomes the new stub; its value is moved out
+        out = std::move(*next->value);
+        next->value.reset();
+        tail_ = next;
+        delete tail;
+        return true;
+    }
+
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        std::optional<T> value; // empty in the stub
+    };
+
+    std::atomic<Node*> head_; // last pushed node; producers swap themselves in here
+    Node* tail_;              // stub before the oldest item; consumer only
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Open-addressing hash map keyed by PID (linear probing, backward-shift
+// deletion, no tombstones). Lookups, inserts and erases are O(1) on average
+// and never allocate except when the table grows. Not synchronized.
+template <typename T>
+class PidMap {
+public:
+    explicit PidMap(size_t initialCapacity = 64) {
+        size_t capacity = 16;
+        while (capacity < initialCapacity) capacity <<= 1;
+        slots_.resize(capacity);
+    }
+
+    // Inserts or overwrites
+    void insert(int pid, const T& value) {
+        if ((size_ + 1) * 4 > slots_.size() * 3) grow(); // max load factor 0.75
+        size_t i = probeStart(pid);
+        while (slots_[i].used) {
+            if (slots_[i].pid == pid) {
+                slots_[i].value = value;
+                return;
+            }
+            i = (i + 1) & mask();
+        }
+        slots_[i].used = true;
+        slots_[i].pid = pid;
+        slots_[i].value = value;
+        ++size_;
+    }
+
+    T* find(int pid) {
+        size_t i = probeStart(pid);
+        while (slots_[i].used) {
+            if (slots_[i].pid == pid) return &slots_[i].value;
+            i = (i + 1) & mask();
+        }
+        return nullptr;
+    }
+
+    const T* find(int pid) const {
+        return const_cast<PidMap*>(this)->find(pid);
+    }
+
+    bool erase(int pid) {
+        size_t i = probeStart(pid);
+        while (slots_[i].used) {
+            if (slots_[i].pid == pid) {
+                removeAt(i);
+                return true;
+            }
+            i = (i + 1) & mask();
+        }
+        return false;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    void clear() {
+        for (auto& slot : slots_) slot = Slot{};
+        size_ = 0;
+    }
+
+private:
+    struct Slot {
+        bool used = false;
+        int pid = 0;
+        T value{};
+    };
+
+    size_t mask() const { return slots_.size() - 1; }
+
+    size_t probeStart(int pid) const {
+        // Fibonacci hashing spreads sequential PIDs across the table
+        uint64_t h = static_cast<uint64_t>(static_cast<uint32_t>(pid)) * 11400714819323198485ull;
+        return static_cast<size_t>(h >> 32) & mask();
+    }
+
+    void removeAt(size_t hole) {
+        // Shift later members of the probe run back so lookups never hit a gap
+        size_t i = hole;
+        while (true) {
+            i = (i + 1) & mask();
+            if (!slots_[i].used) break;
+            size_t home = probeStart(slots_[i].pid);
+            // Move slot i into the hole unless its home lies cyclically in (hole, i]
+            bool homeBetween = hole <= i ? (hole < home && home <= i)
+                                         : (hole < home || home <= i);
+            if (!homeBetween) {
+                slots_[hole] = std::move(slots_[i]);
+                hole = i;
+            }
+        }
+        slots_[hole] = Slot{};
+        --size_;
+    }
+
+    void grow() {
+        std::vector<Slot> old(slots_.size() * 2);
+        old.swap(slots_);
+        size_ = 0;
+        for (auto& slot : old) {
+            if (slot.used) insert(slot.pid, std::move(slot.value));
+        }
+    }
+
+    std::vector<Slot> slots_;
+    size_t size_ = 0;
+};
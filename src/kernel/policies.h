@@ -0,0 +1,477 @@
+#pragma once
+
+#include "fenwick_tree.h"
+#include "fifo_ring.h"
+#include "indexed_heap.h"
+#include "scheduling_policy.h"
+#include <algorithm>
+#include <random>
+#include <set>
+
+// Concrete SchedulingPolicy implementations. makeSchedulingPolicy() picks one
+// at run time; a BasicScheduler can also hold one by value, which lets the
+// compiler resolve and inline every call on the dispatch path. Each is built
+// from (ProcessTable&, const PolicyOptions&).
+
+// Aged priority over ReadyQueue (binary heap or priority buckets)
+class PriorityPolicy : public SchedulingPolicy {
+public:
+    PriorityPolicy(ProcessTable& table, const PolicyOptions& options)
+        : queue_(table, options.queueType, options.priorityLevels) {}
+
+    SchedulingPolicyType type() const override { return SchedulingPolicyType::PRIORITY; }
+    void enqueue(ProcessHandle proc) override { queue_.enqueue(proc); }
+    ProcessHandle dequeue() override { return queue_.dequeue(); }
+    bool remove(ProcessHandle proc) override { return queue_.remove(proc); }
+    size_t size() const override { return queue_.size(); }
+    void setAgingFactor(int seconds) override { queue_.setAgingFactor(seconds); }
+
+private:
+    ReadyQueue queue_;
+};
+
+class FcfsPolicy : public SchedulingPolicy {
+public:
+    FcfsPolicy(ProcessTable&, const PolicyOptions&) {}
+    SchedulingPolicyType type() const override { return SchedulingPolicyType::FCFS; }
+    void enqueue(ProcessHandle proc) override { queue_.push(proc); }
+    ProcessHandle dequeue() override { return queue_.pop(); }
+    bool remove(ProcessHandle proc) override { return queue_.remove(proc); }
+    size_t size() const override { return queue_.size(); }
+
+protected:
+    FifoRing queue_;
+};
+
+// FCFS order, but the running process goes to the back of the queue whenever
+// its quantum expires and someone else is waiting
+class RoundRobinPolicy : public FcfsPolicy {
+public:
+    using FcfsPolicy::FcfsPolicy;
+    SchedulingPolicyType type() const override { return SchedulingPolicyType::ROUND_ROBIN; }
+    bool preemptAtSliceEnd(ProcessHandle) const override { return !queue_.empty(); }
+};
+
+// Orders by one ProcessTable column, then by time entered READY, then by PID
+template <auto Key>
+struct ColumnOrder {
+    const ProcessTable* table;
+
+    bool operator()(ProcessHandle a, ProcessHandle b) const {
+        auto ka = (table->*Key)(a), kb = (table->*Key)(b);
+        if (ka != kb) return ka < kb;
+        if (table->readySince(a) != table->readySince(b)) return table->readySince(a) < table->readySince(b);
+        return table->pid(a) < table->pid(b);
+    }
+};
+
+// Queued processes never execute, so their burst and remaining times and
+// deadlines (the heap keys) are fixed while they sit in the heap
+template <auto Key>
+class ShortestFirstPolicy : public SchedulingPolicy {
+public:
+    ShortestFirstPolicy(ProcessTable& table, const PolicyOptions&) : table_(table), heap_({&table}) {}
+
+    void enqueue(ProcessHandle proc) override { heap_.push(proc); }
+    ProcessHandle dequeue() override { return heap_.pop(); }
+    bool remove(ProcessHandle proc) override { return heap_.remove(proc); }
+    size_t size() const override { return heap_.size(); }
+
+protected:
+    const ProcessTable& table_;
+    IndexedHeap<ColumnOrder<Key>> heap_;
+};
+
+class SjfPolicy : public ShortestFirstPolicy<&ProcessTable::burstTime> {
+public:
+    using ShortestFirstPolicy::ShortestFirstPolicy;
+    SchedulingPolicyType type() const override { return SchedulingPolicyType::SJF; }
+};
+
+class SrtfPolicy : public ShortestFirstPolicy<&ProcessTable::remainingTime> {
+public:
+    using ShortestFirstPolicy::ShortestFirstPolicy;
+    SchedulingPolicyType type() const override { return SchedulingPolicyType::SRTF; }
+
+    bool preemptAtSliceEnd(ProcessHandle current) const override {
+        ProcessHandle best = heap_.top();
+        return best != INVALID_PROCESS && table_.remainingTime(best) < table_.remainingTime(current);
+    }
+    bool preemptOnArrival(ProcessHandle current, ProcessHandle proc) const override {
+        return table_.remainingTime(proc) < table_.remainingTime(current);
+    }
+};
+
+// Earliest deadline first. Only real-time processes have deadlines; the
+// others sort after every pending job and run FIFO in the gaps, without
+// preempting each other.
+class EdfPolicy : public ShortestFirstPolicy<&ProcessTable::deadline> {
+public:
+    using ShortestFirstPolicy::ShortestFirstPolicy;
+    SchedulingPolicyType type() const override { return SchedulingPolicyType::EDF; }
+
+    bool preemptAtSliceEnd(ProcessHandle current) const override {
+        ProcessHandle best = heap_.top();
+        return best != INVALID_PROCESS && table_.deadline(best) < table_.deadline(current);
+    }
+    bool preemptOnArrival(ProcessHandle current, ProcessHandle proc) const override {
+        return table_.deadline(proc) < table_.deadline(current);
+    }
+};
+
+// Linux's nice-to-weight table at every second nice level, so priority 5
+// (nice 0) weighs 1024 and each step is roughly 1.56x. Also the ticket count
+// of the proportional-share policies.
+inline int priorityWeight(int priority) {
+    static const int WEIGHTS[] = {9548, 6100, 3906, 2501, 1586, 1024, 655, 423, 272, 172, 110};
+    return WEIGHTS[std::clamp(priority, 0, 10)];
+}
+
+// Completely fair scheduling. vruntime advances by the time run scaled by
+// NICE_0_WEIGHT / weight, so heavier (higher priority) processes age slower
+// in virtual time; the process with the smallest vruntime runs next. Each
+// runnable process gets a share of the target latency proportional to its
+// weight, so aging needs no periodic pass over the queue.
+class CfsPolicy : public SchedulingPolicy {
+public:
+    static constexpr int TARGET_LATENCY_MS = 200;
+    static constexpr int MIN_GRANULARITY_MS = 10;
+    static constexpr long long WAKEUP_GRANULARITY = 10 * 1000; // vruntime units (us at nice 0)
+
+    CfsPolicy(ProcessTable& table, const PolicyOptions&) : table_(table) {}
+
+    SchedulingPolicyType type() const override { return SchedulingPolicyType::CFS; }
+
+    void enqueue(ProcessHandle proc) override {
+        if (proc < queued_.size() && queued_[proc]) return;
+        if (proc >= queued_.size()) queued_.resize(proc + 1, false);
+
+        // New and waking processes start near the queue's minimum: a sleeper keeps
+        // at most half a latency period of credit, and cannot hoard more
+        long long floor = minVruntime_ - TARGET_LATENCY_MS * 1000LL / 2;
+        table_.setVruntime(proc, std::max(table_.vruntime(proc), floor));
+
+        tree_.insert(key(proc));
+        queued_[proc] = true;
+        queuedWeight_ += weight(proc);
+    }
+
+    ProcessHandle dequeue() override {
+        if (tree_.empty()) return INVALID_PROCESS;
+        ProcessHandle proc = tree_.begin()->proc; // leftmost; std::set caches it
+        erase(proc);
+        advanceMin(table_.vruntime(proc));
+        return proc;
+    }
+
+    bool remove(ProcessHandle proc) override {
+        if (proc >= queued_.size() || !queued_[proc]) return false;
+        erase(proc);
+        return true;
+    }
+
+    size_t size() const override { return tree_.size(); }
+
+    // Target latency split by weight; once too many processes are runnable the
+    // period stretches so no slice drops below the minimum granularity
+    int timeSlice(ProcessHandle proc, int) const override {
+        long long runnable = static_cast<long long>(tree_.size()) + 1;
+        long long period = std::max<long long>(TARGET_LATENCY_MS, runnable * MIN_GRANULARITY_MS);
+        long long totalWeight = queuedWeight_ + weight(proc);
+        return static_cast<int>(std::max<long long>(MIN_GRANULARITY_MS, period * weight(proc) / totalWeight));
+    }
+
+    void charge(ProcessHandle proc, int ranMs) override {
+        table_.setVruntime(proc, table_.vruntime(proc) + ranMs * 1000LL * NICE_0_WEIGHT / weight(proc));
+        long long current = table_.vruntime(proc);
+        advanceMin(tree_.empty() ? current : std::min(current, tree_.begin()->vruntime));
+    }
+
+    bool preemptAtSliceEnd(ProcessHandle current) const override {
+        return !tree_.empty() && tree_.begin()->vruntime < table_.vruntime(current);
+    }
+
+    bool preemptOnArrival(ProcessHandle current, ProcessHandle proc) const override {
+        return table_.vruntime(proc) + WAKEUP_GRANULARITY < table_.vruntime(current);
+    }
+
+private:
+    static constexpr int NICE_0_WEIGHT = 1024;
+
+    struct Key {
+        long long vruntime;
+        int pid; // FIFO among equal vruntimes
+        ProcessHandle proc;
+        bool operator<(const Key& other) const {
+            if (vruntime != other.vruntime) return vruntime < other.vruntime;
+            return pid < other.pid;
+        }
+    };
+
+    int weight(ProcessHandle proc) const { return priorityWeight(table_.priority(proc)); }
+
+    // A queued process's vruntime never changes, so its key can be rebuilt
+    Key key(ProcessHandle proc) const { return {table_.vruntime(proc), table_.pid(proc), proc}; }
+
+    void erase(ProcessHandle proc) {
+        tree_.erase(key(proc));
+        queued_[proc] = false;
+        queuedWeight_ -= weight(proc);
+    }
+
+    void advanceMin(long long vruntime) { minVruntime_ = std::max(minVruntime_, vruntime); }
+
+    ProcessTable& table_;
+    std::set<Key> tree_; // red-black tree ordered by vruntime
+    std::vector<bool> queued_;
+    long long queuedWeight_ = 0;
+    long long minVruntime_ = 0; // monotonic
+};
+
+// Multi-level feedback queue. Level 0 runs first and level L gets a quantum
+// of quantum << L. A process that uses up its level's allotment (the table's
+// vruntime column counts service at the current level) drops one level; one
+// that gives the CPU up earlier keeps it. Every agingFactor seconds all
+// processes return to level 0: the queued ones by splicing each level's list
+// onto level 0, the others lazily because their level belongs to an old epoch.
+class MlfqPolicy : public SchedulingPolicy {
+public:
+    MlfqPolicy(ProcessTable& table, const PolicyOptions& options)
+        : table_(table),
+          head_(std::max(1, options.mlfqLevels), NONE),
+          tail_(std::max(1, options.mlfqLevels), NONE) {}
+
+    SchedulingPolicyType type() const override { return SchedulingPolicyType::MLFQ; }
+
+    void enqueue(ProcessHandle proc) override {
+        if (proc >= queued_.size()) {
+            queued_.resize(proc + 1, false);
+            next_.resize(proc + 1, NONE);
+            prev_.resize(proc + 1, NONE);
+        }
+        if (queued_[proc]) return;
+
+        int level = currentLevel(proc);
+        next_[proc] = NONE;
+        prev_[proc] = tail_[level];
+        if (tail_[level] != NONE) {
+            next_[tail_[level]] = proc;
+        } else {
+            head_[level] = proc;
+        }
+        tail_[level] = proc;
+        queued_[proc] = true;
+        ++size_;
+    }
+
+    ProcessHandle dequeue() override {
+        int level = bestLevel();
+        if (level < 0) return INVALID_PROCESS;
+        ProcessHandle proc = head_[level];
+        unlink(proc, level, level);
+        currentLevel(proc); // a process boosted while queued starts a fresh allotment
+        table_.setLevel(proc, level, epoch_);
+        return proc;
+    }
+
+    bool remove(ProcessHandle proc) override {
+        if (proc >= queued_.size() || !queued_[proc]) return false;
+        // Boosts move nodes between lists without touching them, so the list
+        // is only looked up when proc is at one of its ends
+        int headLevel = prev_[proc] == NONE ? listWith(head_, proc) : -1;
+        int tailLevel = next_[proc] == NONE ? listWith(tail_, proc) : -1;
+        unlink(proc, headLevel, tailLevel);
+        return true;
+    }
+
+    size_t size() const override { return size_; }
+
+    int timeSlice(ProcessHandle proc, int) const override {
+        int level = table_.levelEpoch(proc) == epoch_ ? table_.level(proc) : 0;
+        long long used = table_.levelEpoch(proc) == epoch_ ? table_.vruntime(proc) : 0;
+        return static_cast<int>(std::max<long long>(1, quantum(level) - used));
+    }
+
+    void charge(ProcessHandle proc, int ranMs) override {
+        int level = currentLevel(proc);
+        long long used = table_.vruntime(proc) + ranMs;
+        if (used >= quantum(level)) { // allotment used up: demote
+            level = std::min(level + 1, levels() - 1);
+            used = 0;
+        }
+        table_.setLevel(proc, level, epoch_);
+        table_.setVruntime(proc, used);
+    }
+
+    bool preemptAtSliceEnd(ProcessHandle current) const override {
+        int best = bestLevel();
+        return best >= 0 && best <= table_.level(current); // round-robin within a level
+    }
+
+    bool preemptOnArrival(ProcessHandle current, ProcessHandle proc) const override {
+        int level = table_.levelEpoch(proc) == epoch_ ? table_.level(proc) : 0;
+        return level < table_.level(current);
+    }
+
+    void setAgingFactor(int seconds) override { boostIntervalMs_ = seconds * 1000LL; }
+    void setTimeQuantum(int ms) override { quantumMs_ = ms; }
+
+    void tick(long long now) override {
+        if (boostIntervalMs_ <= 0) return;
+        int epoch = static_cast<int>(now / boostIntervalMs_);
+        if (epoch == epoch_) return;
+        epoch_ = epoch;
+        for (int level = 1; level < levels(); ++level) { // O(levels): splice, keeping FIFO order
+            if (head_[level] == NONE) continue;
+            if (tail_[0] != NONE) {
+                next_[tail_[0]] = head_[level];
+                prev_[head_[level]] = tail_[0];
+            } else {
+                head_[0] = head_[level];
+            }
+            tail_[0] = tail_[level];
+            head_[level] = tail_[level] = NONE;
+        }
+    }
+
+private:
+    static constexpr ProcessHandle NONE = INVALID_PROCESS;
+
+    int levels() const { return static_cast<int>(head_.size()); }
+    long long quantum(int level) const { return static_cast<long long>(quantumMs_) << level; }
+
+    // Level and allotment, reset if a boost has happened since they were set
+    int currentLevel(ProcessHandle proc) {
+        if (table_.levelEpoch(proc) != epoch_) {
+            table_.setLevel(proc, 0, epoch_);
+            table_.setVruntime(proc, 0);
+        }
+        return std::min(table_.level(proc), levels() - 1);
+    }
+
+    int bestLevel() const {
+        for (int level = 0; level < levels(); ++level) {
+            if (head_[level] != NONE) return level;
+        }
+        return -1;
+    }
+
+    static int listWith(const std::vector<ProcessHandle>& ends, ProcessHandle proc) {
+        for (size_t level = 0; level < ends.size(); ++level) {
+            if (ends[level] == proc) return static_cast<int>(level);
+        }
+        return -1;
+    }
+
+    // headLevel/tailLevel: the list whose head/tail proc is, when it is one
+    void unlink(ProcessHandle proc, int headLevel, int tailLevel) {
+        ProcessHandle prev = prev_[proc], next = next_[proc];
+        if (prev != NONE) next_[prev] = next; else head_[headLevel] = next;
+        if (next != NONE) prev_[next] = prev; else tail_[tailLevel] = prev;
+        queued_[proc] = false;
+        --size_;
+    }
+
+    ProcessTable& table_;
+    std::vector<ProcessHandle> head_, tail_; // per level
+    std::vector<ProcessHandle> next_, prev_; // per handle
+    std::vector<bool> queued_;
+    size_t size_ = 0;
+    int quantumMs_ = 100;
+    long long boostIntervalMs_ = 5000;
+    int epoch_ = 0; // boost periods elapsed
+};
+
+// Stride scheduling. Each process advances its pass value by STRIDE1 / tickets
+// per ms run, and the lowest pass runs next, so CPU time converges to the
+// ticket ratio with an error bounded by one slice. The pass lives in the
+// table's vruntime column. A process joining the queue starts no lower than
+// the global pass (the queue's running minimum), so sleeping earns no credit.
+class StridePolicy : public SchedulingPolicy {
+public:
+    static constexpr long long STRIDE1 = 1 << 20;
+
+    StridePolicy(ProcessTable& table, const PolicyOptions&) : table_(table), heap_({&table}) {}
+
+    SchedulingPolicyType type() const override { return SchedulingPolicyType::STRIDE; }
+
+    void enqueue(ProcessHandle proc) override {
+        if (heap_.contains(proc)) return;
+        table_.setVruntime(proc, std::max(table_.vruntime(proc), globalPass_));
+        heap_.push(proc);
+    }
+
+    ProcessHandle dequeue() override {
+        ProcessHandle proc = heap_.pop();
+        if (proc != INVALID_PROCESS) advance(table_.vruntime(proc));
+        return proc;
+    }
+
+    bool remove(ProcessHandle proc) override { return heap_.remove(proc); }
+    size_t size() const override { return heap_.size(); }
+
+    void charge(ProcessHandle proc, int ranMs) override {
+        long long stride = STRIDE1 / priorityWeight(table_.priority(proc));
+        table_.setVruntime(proc, table_.vruntime(proc) + stride * ranMs);
+        ProcessHandle top = heap_.top();
+        advance(top == INVALID_PROCESS ? table_.vruntime(proc)
+                                       : std::min(table_.vruntime(proc), table_.vruntime(top)));
+    }
+
+    bool preemptAtSliceEnd(ProcessHandle current) const override {
+        ProcessHandle top = heap_.top();
+        return top != INVALID_PROCESS && table_.vruntime(top) < table_.vruntime(current);
+    }
+
+private:
+    void advance(long long pass) { globalPass_ = std::max(globalPass_, pass); }
+
+    ProcessTable& table_;
+    IndexedHeap<ColumnOrder<&ProcessTable::vruntime>> heap_; // pass min-heap
+    long long globalPass_ = 0; // monotonic
+};
+
+// Lottery scheduling. Every quantum a ticket is drawn among the queued
+// processes and the running one, which is requeued for the draw. Ticket
+// counts sit in a Fenwick tree indexed by handle, so a draw, an insertion and
+// a removal are each O(log n). Draws come from a seeded mt19937_64 and are
+// reproducible.
+class LotteryPolicy : public SchedulingPolicy {
+public:
+    LotteryPolicy(ProcessTable& table, const PolicyOptions& options) : table_(table), rng_(options.seed) {}
+
+    SchedulingPolicyType type() const override { return SchedulingPolicyType::LOTTERY; }
+
+    void enqueue(ProcessHandle proc) override {
+        if (tickets_.weight(proc) != 0) return; // already queued
+        tickets_.add(proc, priorityWeight(table_.priority(proc)));
+        ++size_;
+    }
+
+    ProcessHandle dequeue() override {
+        if (size_ == 0) return INVALID_PROCESS;
+        auto winner = static_cast<ProcessHandle>(tickets_.find(static_cast<long long>(rng_() % tickets_.total())));
+        take(winner);
+        return winner;
+    }
+
+    bool remove(ProcessHandle proc) override {
+        if (tickets_.weight(proc) == 0) return false;
+        take(proc);
+        return true;
+    }
+
+    size_t size() const override { return size_; }
+    bool preemptAtSliceEnd(ProcessHandle) const override { return size_ > 0; }
+
+private:
+    void take(ProcessHandle proc) {
+        tickets_.add(proc, -tickets_.weight(proc));
+        --size_;
+    }
+
+    const ProcessTable& table_;
+    FenwickTree tickets_; // by handle, 0 when not queued
+    size_t size_ = 0;
+    std::mt19937_64 rng_;
+};
@@ -0,0 +1,113 @@
+#include "priority_buckets.h"
+#include <algorithm>
+
+PriorityBuckets::PriorityBuckets(const ProcessTable& table, int levels)
+    : table_(table),
+      head_(std::max(levels, 1), NIL),
+      tail_(std::max(levels, 1), NIL),
+      bitmap_((head_.size() + 63) / 64, 0) {}
+
+void PriorityBuckets::push(ProcessHandle proc) {
+    if (proc >= level_.size()) {
+        next_.resize(proc + 1, NIL);
+        prev_.resize(proc + 1, NIL);
+        level_.resize(proc + 1, NOT_QUEUED);
+    }
+    if (level_[proc] != NOT_QUEUED) return;
+    link(proc, levelOf(proc));
+}
+
+ProcessHandle PriorityBuckets::pop() {
+    int level = bestLevel();
+    if (level < 0) return INVALID_PROCESS;
+    ProcessHandle proc = head_[level];
+    unlink(proc);
+    return proc;
+}
+
+ProcessHandle PriorityBuckets::front() const {
+    int level = bestLevel();
+    return level < 0 ? INVALID_PROCESS : head_[level];
+}
+
+bool PriorityBuckets::contains(ProcessHandle proc) const {
+    return proc < level_.size() && level_[proc] != NOT_QUEUED;
+}
+
+bool PriorityBuckets::remove(ProcessHandle proc) {
+    if (!contains(proc)) return false;
+    unlink(proc);
+    return true;
+}
+
+void PriorityBuckets::setAgingFactor(int seconds) {
+    agingMs_ = std::max(seconds, 1) * 1000LL;
+}
+
+int PriorityBuckets::levelOf(ProcessHandle proc) const {
+    return std::clamp(table_.priority(proc), 0, levels() - 1);
+}
+
+int PriorityBuckets::bestLevel() const {
+    int best = -1;
+    long long bestKey = 0;
+    for (size_t word = 0; word < bitmap_.size(); ++word) {
+        uint64_t bits = bitmap_[word];
+        while (bits) {
+            int level = static_cast<int>(word * 64 + __builtin_ctzll(bits));
+            bits &= bits - 1;
+            // Same ordering as ProcessComparator: aged key, then PID
+            long long key = level * agingMs_ + table_.readySince(head_[level]);
+            if (best < 0 || key < bestKey ||
+                (key == bestKey && table_.pid(head_[level]) < table_.pid(head_[best]))) {
+                best = level;
+                bestKey = key;
+            }
+        }
+    }
+    return best;
+}
+
+void PriorityBuckets::link(ProcessHandle proc, int level) {
+    // Keep the level sorted by ready time, then PID. Processes usually become ready
+    // in time order and append in O(1); a wake-up timestamped in the past (a timer
+    // that expired between scheduler passes) walks back past the later ones.
+    uint32_t after = tail_[level];
+    while (after != NIL && queuesBehind(after, proc)) {
+        after = prev_[after];
+    }
+    uint32_t before = after != NIL ? next_[after] : head_[level];
+    level_[proc] = level;
+    prev_[proc] = after;
+    next_[proc] = before;
+    if (after != NIL) {
+        next_[after] = proc;
+    } else {
+        head_[level] = proc;
+    }
+    if (before != NIL) {
+        prev_[before] = proc;
+    } else {
+        tail_[level] = proc;
+    }
+    bitmap_[level / 64] |= (uint64_t{1} << (level % 64));
+    count_++;
+}
+
+bool PriorityBuckets::queuesBehind(ProcessHandle a, ProcessHandle b) const {
+    if (table_.readySince(a) != table_.readySince(b)) return table_.readySince(a) > table_.readySince(b);
+    return table_.pid(a) > table_.pid(b);
+}
+
+void PriorityBuckets::unlink(ProcessHandle proc) {
+    int level = level_[proc];
+    if (prev_[proc] != NIL) next_[prev_[proc]] = next_[proc];
+    else head_[level] = next_[proc];
+    if (next_[proc] != NIL) prev_[next_[proc]] = prev_[proc];
+    else tail_[level] = prev_[proc];
+    if (head_[level] == NIL) {
+        bitmap_[level / 64] &= ~(uint64_t{1} << (level % 64));
+    }
+    level_[proc] = NOT_QUEUED;
+    count_--;
+}
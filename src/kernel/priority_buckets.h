@@ -0,0 +1,54 @@
+#pragma once
+
+#include "process_table.h"
+#include <cstdint>
+#include <vector>
+
+// Run queue with one list per base priority level, ordered by ready time
+// then PID, and a bitmap of non-empty levels. Level 0 is the highest priority;
+// priorities outside [0, levels) are clamped. The lists are intrusive
+// (next/prev arrays indexed by ProcessHandle), so removal is O(1), enqueue is
+// O(1) for processes that become ready in time order, and neither allocates
+// once the arrays have grown to the table size.
+//
+// Aging is lazy (see ProcessComparator): within a level the head is always the
+// longest-waiting, most-aged process, so dequeue compares the heads of the
+// non-empty levels found in the bitmap: O(non-empty levels). The highest
+// non-empty level alone is not enough, since a long wait lets a head outrank
+// any number of levels above it. For priorities in range the order is exactly
+// ProcessComparator's, so both ReadyQueue types select the same process.
+// Not synchronized.
+class PriorityBuckets {
+public:
+    explicit PriorityBuckets(const ProcessTable& table, int levels = 11);
+
+    void push(ProcessHandle proc); // into its level, behind every process ready no later
+    ProcessHandle pop();           // most-aged level head, INVALID_PROCESS when empty
+    ProcessHandle front() const;
+    bool empty() const { return count_ == 0; }
+    size_t size() const { return count_; }
+    bool contains(ProcessHandle proc) const;
+    bool remove(ProcessHandle proc);
+    void setAgingFactor(int seconds);
+    int levels() const { return static_cast<int>(head_.size()); }
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+    static constexpr int NOT_QUEUED = -1;
+
+    int levelOf(ProcessHandle proc) const;
+    int bestLevel() const; // level whose head has the best aged priority, -1 when empty; O(non-empty levels)
+    void link(ProcessHandle proc, int level);
+    bool queuesBehind(ProcessHandle a, ProcessHandle b) const; // a queues behind b within a level
+    void unlink(ProcessHandle proc);
+
+    const ProcessTable& table_;
+    std::vector<uint32_t> head_;   // per level
+    std::vector<uint32_t> tail_;   // per level
+    std::vector<uint32_t> next_;   // per handle
+    std::vector<uint32_t> prev_;   // per handle
+    std::vector<int> level_;       // per handle, NOT_QUEUED if absent
+    std::vector<uint64_t> bitmap_; // bit set = level has at least one process
+    size_t count_ = 0;
+    long long agingMs_ = 5000;
+};
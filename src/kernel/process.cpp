@@ -1,32 +1,26 @@
 #include "process.h"
-#include <iostream>
 
-Process::Process(int pid, const std::string& name, int priority, int burstTime)
-    : pid_(pid), name_(name), basePriority_(priority), effectivePriority_(priority),
-      burstTime_(burstTime), remainingTime_(burstTime) {}
+Process::Process(int pid, const std::string& name, int priority, int burstTime,
+                 int remainingTime, ProcessState state, long long readySince)
+    : pid_(pid), name_(name), basePriority_(priority), burstTime_(burstTime),
+      remainingTime_(remainingTime), state_(state), readySince_(readySince) {}
 
 Process::~Process() {}
 
 int Process::getPid() const { return pid_; }
 const std::string& Process::getName() const { return name_; }
 int Process::getPriority() const { return basePriority_; }
-int Process::getEffectivePriority() const { return effectivePriority_; }
 int Process::getBurstTime() const { return burstTime_; }
 int Process::getRemainingTime() const { return remainingTime_; }
 ProcessState Process::getState() const { return state_; }
+long long Process::getReadySince() const { return readySince_; }
 
-void Process::setState(ProcessState state) { state_ = state; }
-
-void Process::execute(int timeSlice) {
-    if (state_ != ProcessState::RUNNING) return;
-    int execTime = std::min(timeSlice, remainingTime_);
-    remainingTime_ -= execTime;
-    if (remainingTime_ == 0) {
-        state_ = ProcessState::TERMINATED;
-    }
+int Process::getEffectivePriority(long long now, int agingFactorSec) const {
+    if (state_ != ProcessState::READY) return basePriority_;
+    return agedPriority(basePriority_, readySince_, now, agingFactorSec);
 }
 
-void Process::applyAging(int agingFactor) {
-    // Simple aging: increase effective priority based on wait time
-    effectivePriority_ = basePriority_ + (waitTime / agingFactor);
+int Process::getWaitTime(long long now) const {
+    if (state_ != ProcessState::READY) return waitTime;
+    return waitTime + static_cast<int>(now - readySince_);
 }
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <string>
-#include <memory>
+#include <algorithm>
 
 enum class ProcessState {
     NEW,
@@ -11,34 +11,43 @@ enum class ProcessState {
     TERMINATED
 };
 
+// Aging is a pure function of (base priority, time the process became READY, now):
+// one level better per agingFactor seconds spent READY, never above 0
+inline int agedPriority(int basePriority, long long readySince, long long now, int agingFactorSec) {
+    if (agingFactorSec <= 0) return basePriority;
+    long long boost = (now - readySince) / (agingFactorSec * 1000LL);
+    return static_cast<int>(std::max(0LL, basePriority - boost));
+}
+
+// Read-only copy of one ProcessTable row (the PCB), handed out to the GUI and reports
 class Process {
 public:
-    Process(int pid, const std::string& name, int priority, int burstTime);
+    Process(int pid, const std::string& name, int priority, int burstTime,
+            int remainingTime, ProcessState state, long long readySince);
     ~Process();
 
     int getPid() const;
     const std::string& getName() const;
     int getPriority() const;
-    int getEffectivePriority() const;
     int getBurstTime() const;
     int getRemainingTime() const;
     ProcessState getState() const;
 
-    void setState(ProcessState state);
-    void execute(int timeSlice); // simulate execution for given time slice
-    void applyAging(int agingFactor); // boost priority based on waiting time
+    int getEffectivePriority(long long now, int agingFactorSec) const;
+    long long getReadySince() const;
+    int getWaitTime(long long now) const; // includes the current stretch in READY
 
     // Timing info
-    mutable int arrivalTime = 0;
-    mutable int waitTime = 0;
-    mutable int turnaroundTime = 0;
+    int arrivalTime = 0;
+    int waitTime = 0;
+    int turnaroundTime = 0;
 
 private:
     int pid_;
     std::string name_;
     int basePriority_;
-    int effectivePriority_;
     int burstTime_;
     int remainingTime_;
-    ProcessState state_ = ProcessState::NEW;
+    ProcessState state_;
+    long long readySince_;
 };
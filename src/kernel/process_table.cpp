@@ -0,0 +1,237 @@
+#include "process_table.h"
+#include <algorithm>
+#include <iterator>
+
+ProcessHandle ProcessTable::add(int pid, const std::string& name, int priority, int burstTime, int arrivalTime) {
+    if (!free_.empty()) {
+        ProcessHandle h = free_.back();
+        free_.pop_back();
+        pid_[h] = pid;
+        state_[h] = ProcessState::NEW;
+        basePriority_[h] = priority;
+        burstTime_[h] = burstTime;
+        remainingTime_[h] = burstTime;
+        readySince_[h] = 0;
+        arrivalTime_[h] = arrivalTime;
+        waitTime_[h] = 0;
+        turnaroundTime_[h] = 0;
+        cpu_[h] = -1;
+        vruntime_[h] = 0;
+        level_[h] = 0;
+        levelEpoch_[h] = 0;
+        deadline_[h] = NO_DEADLINE;
+        responseTime_[h] = NOT_ARRIVED;
+        name_[h].assign(name); // reuses the old string's buffer
+        realTime_[h] = RealTimeParams();
+        release_[h] = arrivalTime;
+        enter(h);
+        return h;
+    }
+
+    auto h = static_cast<ProcessHandle>(pid_.size());
+    pid_.push_back(pid);
+    state_.push_back(ProcessState::NEW);
+    basePriority_.push_back(priority);
+    burstTime_.push_back(burstTime);
+    remainingTime_.push_back(burstTime);
+    readySince_.push_back(0);
+    arrivalTime_.push_back(arrivalTime);
+    waitTime_.push_back(0);
+    turnaroundTime_.push_back(0);
+    cpu_.push_back(-1);
+    vruntime_.push_back(0);
+    level_.push_back(0);
+    levelEpoch_.push_back(0);
+    deadline_.push_back(NO_DEADLINE);
+    responseTime_.push_back(NOT_ARRIVED);
+    name_.push_back(name);
+    realTime_.emplace_back();
+    release_.push_back(arrivalTime);
+    enter(h);
+    return h;
+}
+
+void ProcessTable::retire(ProcessHandle h) {
+    leave(h);
+    retiredCount_++;
+    retiredWait_ += waitTime_[h];
+    retiredTurnaround_ += turnaroundTime_[h];
+    if (responseTime_[h] != NOT_ARRIVED) { // killed before arrival: no latency to speak of
+        latency_.wait.record(waitTime_[h]);
+        latency_.turnaround.record(turnaroundTime_[h]);
+    }
+
+    if (retiredHistoryLimit_ > 0) {
+        if (retiredHistory_.size() == retiredHistoryLimit_) {
+            retiredHistory_.pop_front();
+        }
+        retiredHistory_.push_back(snapshot(h, 0)); // finished, so now is not used
+    }
+
+    pid_[h] = FREE_PID;
+    state_[h] = ProcessState::TERMINATED;
+    free_.push_back(h);
+}
+
+void ProcessTable::setRetiredHistoryLimit(size_t limit) {
+    retiredHistoryLimit_ = limit;
+    if (retiredHistory_.size() > limit) {
+        retiredHistory_.erase(retiredHistory_.begin(), retiredHistory_.end() - limit);
+    }
+}
+
+void ProcessTable::reserve(size_t count) {
+    pid_.reserve(count);
+    state_.reserve(count);
+    basePriority_.reserve(count);
+    burstTime_.reserve(count);
+    remainingTime_.reserve(count);
+    readySince_.reserve(count);
+    arrivalTime_.reserve(count);
+    waitTime_.reserve(count);
+    turnaroundTime_.reserve(count);
+    cpu_.reserve(count);
+    vruntime_.reserve(count);
+    level_.reserve(count);
+    levelEpoch_.reserve(count);
+    deadline_.reserve(count);
+    responseTime_.reserve(count);
+    name_.reserve(count);
+    realTime_.reserve(count);
+    release_.reserve(count);
+    free_.reserve(count);
+}
+
+void ProcessTable::resetPolicyState() {
+    std::fill(vruntime_.begin(), vruntime_.end(), 0);
+    std::fill(level_.begin(), level_.end(), 0);
+    std::fill(levelEpoch_.begin(), levelEpoch_.end(), 0);
+}
+
+void ProcessTable::setRealTime(ProcessHandle h, const RealTimeParams& params, long long releaseMs) {
+    realTime_[h] = params;
+    release_[h] = releaseMs;
+    deadline_[h] = releaseMs + params.relativeDeadline();
+    burstTime_[h] = remainingTime_[h] = params.wcetMs;
+}
+
+bool ProcessTable::releaseJob(ProcessHandle h, long long releaseMs) {
+    RealTimeParams& params = realTime_[h];
+    if (params.jobs <= 1) return false;
+    params.jobs--;
+    release_[h] = releaseMs;
+    deadline_[h] = releaseMs + params.relativeDeadline();
+    remainingTime_[h] = params.wcetMs;
+    return true;
+}
+
+long long RealTimeParams::densityPpm() const {
+    long long window = std::min(periodMs, relativeDeadline());
+    if (window <= 0) return 1000000;
+    return (wcetMs * 1000000LL + window - 1) / window; // rounded up, so admission errs safe
+}
+
+int ProcessTable::waitTime(ProcessHandle h, long long now) const {
+    if (state_[h] != ProcessState::READY) return waitTime_[h];
+    return waitTime_[h] + static_cast<int>(now - readySince_[h]);
+}
+
+int ProcessTable::effectivePriority(ProcessHandle h, long long now, int agingFactorSec) const {
+    if (state_[h] != ProcessState::READY) return basePriority_[h];
+    return agedPriority(basePriority_[h], readySince_[h], now, agingFactorSec);
+}
+
+int ProcessTable::turnaroundTime(ProcessHandle h, long long now) const {
+    ProcessState state = state_[h];
+    if (state == ProcessState::NEW || state == ProcessState::TERMINATED) return turnaroundTime_[h];
+    return static_cast<int>(now) - arrivalTime_[h];
+}
+
+void ProcessTable::setState(ProcessHandle h, ProcessState state) {
+    leave(h);
+    state_[h] = state;
+    enter(h);
+}
+
+void ProcessTable::setState(ProcessHandle h, ProcessState state, long long now) {
+    leave(h);
+    if (state == ProcessState::RUNNING && responseTime_[h] < 0) {
+        responseTime_[h] = static_cast<int>(now) - arrivalTime_[h];
+        latency_.response.record(responseTime_[h]);
+    } else if (responseTime_[h] == NOT_ARRIVED && state != ProcessState::NEW &&
+               state != ProcessState::TERMINATED) {
+        responseTime_[h] = NOT_STARTED;
+    }
+    if (state_[h] == ProcessState::READY && state != ProcessState::READY) {
+        waitTime_[h] += static_cast<int>(now - readySince_[h]);
+    } else if (state_[h] != ProcessState::READY && state == ProcessState::READY) {
+        readySince_[h] = now;
+    }
+    state_[h] = state;
+    enter(h);
+}
+
+void ProcessTable::setTurnaroundTime(ProcessHandle h, int ms) {
+    leave(h);
+    turnaroundTime_[h] = ms;
+    enter(h);
+}
+
+int ProcessTable::execute(ProcessHandle h, int timeSlice) {
+    if (state_[h] != ProcessState::RUNNING) return 0;
+    int execTime = std::min(timeSlice, remainingTime_[h]);
+    remainingTime_[h] -= execTime;
+    if (remainingTime_[h] == 0) {
+        setState(h, ProcessState::TERMINATED);
+    }
+    return execTime;
+}
+
+void ProcessTable::leave(ProcessHandle h) {
+    ProcessState state = state_[h];
+    stateCount_[static_cast<int>(state)]--;
+    if (state == ProcessState::NEW) return;
+    waitSum_ -= waitTime_[h];
+    if (state == ProcessState::TERMINATED) {
+        finishedTurnaroundSum_ -= turnaroundTime_[h];
+        return;
+    }
+    activeArrivalSum_ -= arrivalTime_[h];
+    if (state == ProcessState::READY) readySinceSum_ -= readySince_[h];
+}
+
+void ProcessTable::enter(ProcessHandle h) {
+    ProcessState state = state_[h];
+    stateCount_[static_cast<int>(state)]++;
+    if (state == ProcessState::NEW) return;
+    waitSum_ += waitTime_[h];
+    if (state == ProcessState::TERMINATED) {
+        finishedTurnaroundSum_ += turnaroundTime_[h];
+        return;
+    }
+    activeArrivalSum_ += arrivalTime_[h];
+    if (state == ProcessState::READY) readySinceSum_ += readySince_[h];
+}
+
+ProcessTable::Summary ProcessTable::summary(long long now) const {
+    Summary summary;
+    std::copy(std::begin(stateCount_), std::end(stateCount_), std::begin(summary.count));
+    summary.count[static_cast<int>(ProcessState::TERMINATED)] += retiredCount_;
+
+    int ready = stateCount_[static_cast<int>(ProcessState::READY)];
+    int active = ready + stateCount_[static_cast<int>(ProcessState::RUNNING)] +
+                 stateCount_[static_cast<int>(ProcessState::WAITING)];
+    // Each READY row adds now - readySince, each unfinished row now - arrival
+    summary.totalWait = retiredWait_ + waitSum_ + ready * now - readySinceSum_;
+    summary.totalTurnaround = retiredTurnaround_ + finishedTurnaroundSum_ + active * now - activeArrivalSum_;
+    return summary;
+}
+
+Process ProcessTable::snapshot(ProcessHandle h, long long now) const {
+    Process proc(pid_[h], name_[h], basePriority_[h], burstTime_[h],
+                 remainingTime_[h], state_[h], readySince_[h]);
+    proc.arrivalTime = arrivalTime_[h];
+    proc.waitTime = waitTime_[h];
+    proc.turnaroundTime = turnaroundTime(h, now);
+    return proc;
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "process.h"
+#include "latency_histogram.h"
+#include <climits>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+// Dense index of a row in ProcessTable. Rows are recycled once a process is
+// retired, so a handle is only meaningful while its PID still matches.
+using ProcessHandle = uint32_t;
+constexpr ProcessHandle INVALID_PROCESS = UINT32_MAX;
+
+enum class RealTimeKind {
+    NONE,     // ordinary process: one burst, no deadline
+    PERIODIC, // releases a job every periodMs
+    SPORADIC  // releases a job at irregular intervals, never closer than periodMs
+};
+
+// Timing of a real-time process, all in ms. Each job needs up to wcetMs of CPU
+// and must finish within deadlineMs of its release.
+struct RealTimeParams {
+    RealTimeKind kind = RealTimeKind::NONE;
+    int periodMs = 0;   // period, or minimum inter-arrival time when sporadic
+    int wcetMs = 0;     // worst-case execution time of one job
+    int deadlineMs = 0; // relative to the release; 0 means the period
+    int jobs = 1;       // releases before the process terminates
+
+    int relativeDeadline() const { return deadlineMs > 0 ? deadlineMs : periodMs; }
+    // CPU share the process can demand, in millionths: wcet / min(period, deadline)
+    long long densityPpm() const;
+};
+
+constexpr long long NO_DEADLINE = LLONG_MAX;
+
+// Column-oriented process table. Every hot scheduling field lives in its own
+// contiguous array indexed by ProcessHandle, so the scheduler, the run queues
+// and the statistics pass walk plain arrays instead of chasing one heap object
+// per process. Names are kept in a separate cold column.
+// Retired rows go on a free list and are reused by the next add(), so the
+// table stays as large as the peak number of live processes; the retired
+// processes survive as running totals and a cold snapshot history for the
+// process views, unbounded unless setRetiredHistoryLimit() caps it.
+// Every transition also updates per-state counts and running sums, so the
+// statistics summary is O(1) however many processes there are.
+// Not synchronized: the Scheduler lock protects it.
+class ProcessTable {
+public:
+    // Aggregates over every process, retired ones included
+    struct Summary {
+        int count[5] = {0, 0, 0, 0, 0}; // indexed by ProcessState, retired rows count as TERMINATED
+        long long totalWait = 0;
+        long long totalTurnaround = 0;
+    };
+
+    static constexpr size_t UNLIMITED_HISTORY = SIZE_MAX;
+
+    ProcessHandle add(int pid, const std::string& name, int priority, int burstTime, int arrivalTime);
+    // Folds the row into the retired totals and returns it to the free list.
+    // Every reference held by queues, timers or events must already be gone.
+    void retire(ProcessHandle h);
+    bool isLive(ProcessHandle h) const { return h < pid_.size() && pid_[h] != FREE_PID; }
+    size_t size() const { return pid_.size(); } // rows, including free ones
+    size_t liveCount() const { return pid_.size() - free_.size(); }
+    void reserve(size_t count);
+
+    int pid(ProcessHandle h) const { return pid_[h]; }
+    const std::string& name(ProcessHandle h) const { return name_[h]; }
+    int priority(ProcessHandle h) const { return basePriority_[h]; }
+    int burstTime(ProcessHandle h) const { return burstTime_[h]; }
+    int remainingTime(ProcessHandle h) const { return remainingTime_[h]; }
+    ProcessState state(ProcessHandle h) const { return state_[h]; }
+    long long readySince(ProcessHandle h) const { return readySince_[h]; }
+    int arrivalTime(ProcessHandle h) const { return arrivalTime_[h]; }
+    int turnaroundTime(ProcessHandle h) const { return turnaroundTime_[h]; } // final once TERMINATED
+    int turnaroundTime(ProcessHandle h, long long now) const; // measured up to now while unfinished
+    int cpu(ProcessHandle h) const { return cpu_[h]; } // owning CPU, -1 before first placement
+    long long vruntime(ProcessHandle h) const { return vruntime_[h]; } // policy-defined virtual time
+    int level(ProcessHandle h) const { return level_[h]; }             // feedback-queue level
+    int levelEpoch(ProcessHandle h) const { return levelEpoch_[h]; }   // boost period the level belongs to
+    long long deadline(ProcessHandle h) const { return deadline_[h]; }  // current job's, absolute
+    bool isRealTime(ProcessHandle h) const { return realTime_[h].kind != RealTimeKind::NONE; }
+    const RealTimeParams& realTime(ProcessHandle h) const { return realTime_[h]; }
+    long long release(ProcessHandle h) const { return release_[h]; }    // current job's release time
+    int responseTime(ProcessHandle h) const { return responseTime_[h]; } // first dispatch minus arrival, < 0 before
+    int waitTime(ProcessHandle h, long long now) const; // includes the current stretch in READY
+    int effectivePriority(ProcessHandle h, long long now, int agingFactorSec) const;
+
+    void setState(ProcessHandle h, ProcessState state);
+    // Timestamped transition: entering READY starts the aging/wait clock,
+    // leaving READY folds the elapsed stretch into the wait time
+    void setState(ProcessHandle h, ProcessState state, long long now);
+    void setTurnaroundTime(ProcessHandle h, int ms);
+    void setCpu(ProcessHandle h, int cpu) { cpu_[h] = cpu; }
+    void setVruntime(ProcessHandle h, long long vruntime) { vruntime_[h] = vruntime; }
+    void setLevel(ProcessHandle h, int level, int epoch) { level_[h] = level; levelEpoch_[h] = epoch; }
+    void resetPolicyState(); // clears vruntime and level of every row, for a policy switch
+    // Makes h a real-time process whose first job is released at releaseMs
+    void setRealTime(ProcessHandle h, const RealTimeParams& params, long long releaseMs);
+    // Releases the next job at releaseMs; false once every job has been released
+    bool releaseJob(ProcessHandle h, long long releaseMs);
+    int execute(ProcessHandle h, int timeSlice); // simulate execution; returns ms actually run
+
+    // Distributions over retired processes (response: over every first dispatch)
+    const LatencyStats& latency() const { return latency_; }
+
+    // O(1): derived from the totals kept on every transition. Waits and
+    // turnarounds of unfinished processes are measured up to now.
+    Summary summary(long long now) const;
+
+    Process snapshot(ProcessHandle h, long long now) const;
+    const std::deque<Process>& retiredHistory() const { return retiredHistory_; } // oldest first
+    // Snapshots kept after retirement; the oldest go first once over the limit
+    void setRetiredHistoryLimit(size_t limit);
+    size_t retiredHistoryLimit() const { return retiredHistoryLimit_; }
+
+private:
+    static constexpr int FREE_PID = -1;
+    static constexpr int NOT_ARRIVED = -2; // responseTime_ of a NEW row
+    static constexpr int NOT_STARTED = -1; // responseTime_ of an arrived row never dispatched
+
+    std::vector<int> pid_;
+    std::vector<ProcessState> state_;
+    std::vector<int> basePriority_;
+    std::vector<int> burstTime_;
+    std::vector<int> remainingTime_;
+    std::vector<long long> readySince_;
+    std::vector<int> arrivalTime_;
+    std::vector<int> waitTime_;
+    std::vector<int> turnaroundTime_;
+    std::vector<int> cpu_;
+    std::vector<long long> vruntime_;
+    std::vector<int> level_;
+    std::vector<int> levelEpoch_;
+    std::vector<long long> deadline_;
+    std::vector<int> responseTime_;
+    std::vector<std::string> name_; // cold
+    std::vector<RealTimeParams> realTime_; // cold
+    std::vector<long long> release_;       // cold
+
+    // A live row's contribution to the totals below; every write to its state,
+    // wait, ready time or turnaround sits between leave() and enter()
+    void leave(ProcessHandle h);
+    void enter(ProcessHandle h);
+
+    // Totals over live rows
+    int stateCount_[5] = {0, 0, 0, 0, 0};
+    long long waitSum_ = 0;         // stored wait times of arrived rows
+    long long readySinceSum_ = 0;   // READY rows
+    long long activeArrivalSum_ = 0; // READY, RUNNING and WAITING rows
+    long long finishedTurnaroundSum_ = 0; // TERMINATED rows not yet retired
+
+    std::vector<ProcessHandle> free_;
+    int retiredCount_ = 0;
+    long long retiredWait_ = 0;
+    long long retiredTurnaround_ = 0;
+    std::deque<Process> retiredHistory_;
+    size_t retiredHistoryLimit_ = UNLIMITED_HISTORY;
+    LatencyStats latency_;
+};
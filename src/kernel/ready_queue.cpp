@@ -1,54 +1,51 @@
 #include "ready_queue.h"
+#include <algorithm>
 
-ReadyQueue::ReadyQueue() {}
+ReadyQueue::ReadyQueue(const ProcessTable& table, ReadyQueueType type, int priorityLevels)
+    : type_(type),
+      buckets_(table, type == ReadyQueueType::PRIORITY_BUCKETS ? priorityLevels : 1),
+      heap_(ProcessComparator{&table}) {}
 ReadyQueue::~ReadyQueue() {}
 
-void ReadyQueue::enqueue(const std::shared_ptr<Process>& proc) {
-    SpinlockGuard guard(lock_);
-    queue_.push(proc);
+ReadyQueueType ReadyQueue::getType() const { return type_; }
+
+void ReadyQueue::enqueue(ProcessHandle proc) {
+    if (type_ == ReadyQueueType::PRIORITY_BUCKETS) {
+        buckets_.push(proc);
+    } else {
+        heap_.push(proc);
+    }
 }
 
-std::shared_ptr<Process> ReadyQueue::dequeue() {
-    SpinlockGuard guard(lock_);
-    if (queue_.empty()) return nullptr;
-    auto top = queue_.top();
-    queue_.pop();
-    return top;
+ProcessHandle ReadyQueue::dequeue() {
+    return type_ == ReadyQueueType::PRIORITY_BUCKETS ? buckets_.pop() : heap_.pop();
 }
 
-std::shared_ptr<Process> ReadyQueue::peek() const {
-    // Note: const method, cannot lock mutable lock_; use mutable lock for simplicity
-    const_cast<Spinlock&>(lock_).lock();
-    if (queue_.empty()) {
-        const_cast<Spinlock&>(lock_).unlock();
-        return nullptr;
-    }
-    auto top = queue_.top();
-    const_cast<Spinlock&>(lock_).unlock();
-    return top;
+ProcessHandle ReadyQueue::peek() const {
+    return type_ == ReadyQueueType::PRIORITY_BUCKETS ? buckets_.front() : heap_.top();
 }
 
 bool ReadyQueue::empty() const {
-    const_cast<Spinlock&>(lock_).lock();
-    bool isEmpty = queue_.empty();
-    const_cast<Spinlock&>(lock_).unlock();
-    return isEmpty;
-}
-
-void ReadyQueue::applyAging(int agingFactor) {
-    // Apply aging to all processes in the queue by rebuilding the priority queue
-    std::vector<std::shared_ptr<Process>> temp;
-    {
-        SpinlockGuard guard(lock_);
-        while (!queue_.empty()) {
-            auto proc = queue_.top();
-            queue_.pop();
-            proc->applyAging(agingFactor);
-            temp.push_back(proc);
-        }
-        // Reinsert with updated priorities (effective priority stored inside Process)
-        for (auto& p : temp) {
-            queue_.push(p);
-        }
+    return type_ == ReadyQueueType::PRIORITY_BUCKETS ? buckets_.empty() : heap_.empty();
+}
+
+size_t ReadyQueue::size() const {
+    return type_ == ReadyQueueType::PRIORITY_BUCKETS ? buckets_.size() : heap_.size();
+}
+
+bool ReadyQueue::contains(ProcessHandle proc) const {
+    return type_ == ReadyQueueType::PRIORITY_BUCKETS ? buckets_.contains(proc) : heap_.contains(proc);
+}
+
+bool ReadyQueue::remove(ProcessHandle proc) {
+    return type_ == ReadyQueueType::PRIORITY_BUCKETS ? buckets_.remove(proc) : heap_.remove(proc);
+}
+
+void ReadyQueue::setAgingFactor(int seconds) {
+    heap_.before().agingMs = std::max(seconds, 1) * 1000LL;
+    if (type_ == ReadyQueueType::PRIORITY_BUCKETS) {
+        buckets_.setAgingFactor(seconds);
+        return;
     }
+    heap_.rebuild(); // keys depend on the factor: heapify in place (O(n), no allocation)
 }
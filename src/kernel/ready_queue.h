@@ -1,31 +1,66 @@
 #pragma once
 
-#include "process.h"
-#include "spinlock.h"
-#include <queue>
-#include <vector>
-#include <functional>
+#include "process_table.h"
+#include "indexed_heap.h"
+#include "priority_buckets.h"
 
-// Comparator for effective priority (higher priority = lower numeric value)
+// Orders processes by aged priority (higher priority = lower numeric value).
+// Aging lowers the effective priority by one level per agingFactor seconds in READY:
+//   effective(now) * agingMs = base * agingMs - (now - readySince)
+// "now" is common to both sides of a comparison, so the order is fixed by
+// base * agingMs + readySince and never changes while processes are queued.
 struct ProcessComparator {
-    bool operator()(const std::shared_ptr<Process>& a, const std::shared_ptr<Process>& b) const {
-        // lower effectivePriority means higher priority
-        return a->getEffectivePriority() > b->getEffectivePriority();
+    const ProcessTable* table = nullptr;
+    long long agingMs = 5000;
+
+    long long key(ProcessHandle h) const {
+        return table->priority(h) * agingMs + table->readySince(h);
+    }
+
+    // true if a should be scheduled before b (IndexedHeap convention)
+    bool operator()(ProcessHandle a, ProcessHandle b) const {
+        long long ka = key(a), kb = key(b);
+        if (ka != kb) return ka < kb;
+        return table->pid(a) < table->pid(b);
     }
 };
 
+// Run queue implementation, chosen when the queue is constructed
+enum class ReadyQueueType {
+    BINARY_HEAP,      // indexed binary heap, O(log n)
+    PRIORITY_BUCKETS  // time-ordered bucket per priority level + bitmap; pop O(non-empty levels)
+};
+
+// Default number of priority levels (0-10, as accepted by the GUI and kernel module)
+constexpr int DEFAULT_PRIORITY_LEVELS = 11;
+
+// Holds handles into a ProcessTable, which must outlive the queue.
+// BINARY_HEAP: an IndexedHeap ordered by ProcessComparator, so a single entry
+// can be removed in O(log n) without a rebuild.
+// PRIORITY_BUCKETS: see PriorityBuckets; same selection order as BINARY_HEAP.
+// Processes must be READY (with their ready timestamp set) before enqueue.
+// Not synchronized: like every run queue, it is only touched under the
+// Scheduler lock.
 class ReadyQueue {
 public:
-    ReadyQueue();
+    explicit ReadyQueue(const ProcessTable& table,
+                        ReadyQueueType type = ReadyQueueType::BINARY_HEAP,
+                        int priorityLevels = DEFAULT_PRIORITY_LEVELS);
     ~ReadyQueue();
 
-    void enqueue(const std::shared_ptr<Process>& proc);
-    std::shared_ptr<Process> dequeue();
-    std::shared_ptr<Process> peek() const;
+    ReadyQueueType getType() const;
+
+    void enqueue(ProcessHandle proc); // no-op if already queued
+    ProcessHandle dequeue();          // INVALID_PROCESS when empty
+    ProcessHandle peek() const;
     bool empty() const;
-    void applyAging(int agingFactor);
+    size_t size() const;
+    bool contains(ProcessHandle proc) const;
+    bool remove(ProcessHandle proc);  // O(log n); false if not queued
+    void setAgingFactor(int seconds); // reorders the queue; aging itself needs no per-tick work
 
 private:
-    std::priority_queue<std::shared_ptr<Process>, std::vector<std::shared_ptr<Process>>, ProcessComparator> queue_;
-    Spinlock lock_;
+    ReadyQueueType type_;
+    PriorityBuckets buckets_;
+    IndexedHeap<ProcessComparator> heap_;
 };
@@ -4,215 +4,1355 @@
 #include <chrono>
 #include <algorithm>
 #include <cstdlib>
+#include <type_traits>
 
-Scheduler::Scheduler() {}
-Scheduler::~Scheduler() { stop(); }
+namespace {
 
-void Scheduler::setTimeQuantum(int ms) { timeQuantumMs_ = ms; }
-void Scheduler::setAgingFactor(int seconds) { agingFactorSec_ = seconds; }
+PolicyOptions priorityQueueOptions(ReadyQueueType queueType, int priorityLevels) {
+    PolicyOptions options;
+    options.queueType = queueType;
+    options.priorityLevels = priorityLevels;
+    return options;
+}
 
-std::shared_ptr<Process> Scheduler::createProcess(const std::string& name, int priority, int burstTime) {
-    static int nextPid = 1;
-    static auto startTime = std::chrono::steady_clock::now();
-    
-    auto proc = std::make_shared<Process>(nextPid++, name, priority, burstTime);
-    proc->setState(ProcessState::NEW);
-    
-    // Set arrival time
-    auto now = std::chrono::steady_clock::now();
-    proc->arrivalTime = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime).count();
-    
+// A task may stop the scheduler from inside its own worker
+void joinUnlessSelf(std::thread& thread) {
+    if (thread.get_id() == std::this_thread::get_id()) {
+        thread.detach();
+    } else if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+} // namespace
+
+template <typename Policy, typename Clock, typename StatsSink>
+BasicScheduler<Policy, Clock, StatsSink>::BasicScheduler(ReadyQueueType queueType, int priorityLevels, int cpuCount)
+    : BasicScheduler(priorityQueueOptions(queueType, priorityLevels), cpuCount) {}
+
+template <typename Policy, typename Clock, typename StatsSink>
+BasicScheduler<Policy, Clock, StatsSink>::BasicScheduler(const PolicyOptions& options, int cpuCount)
+    : policyOptions_(options) {
+    cpuCount = std::max(1, cpuCount);
+    cpus_.reserve(cpuCount);
+    for (int i = 0; i < cpuCount; ++i) {
+        cpus_.push_back(std::make_unique<Cpu>(table_, policyOptions(i)));
+        configurePolicy(i);
+    }
+    refreshHistograms();
+    if constexpr (StatsSink::LIVE) {
+        publishStats(collectStats()); // readers see the CPU list from the start
+    }
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+BasicScheduler<Policy, Clock, StatsSink>::~BasicScheduler() { stop(); }
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::setTimeQuantum(int ms) {
+    LockGuard guard(lock_);
+    timeQuantumMs_ = ms;
+    for (auto& cpu : cpus_) {
+        cpu->policy.setTimeQuantum(ms);
+    }
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::setAgingFactor(int seconds) {
+    LockGuard guard(lock_);
+    agingFactorSec_ = seconds;
+    for (auto& cpu : cpus_) {
+        cpu->policy.setAgingFactor(seconds);
+    }
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::setMlfqLevels(int levels) {
+    LockGuard guard(lock_);
+    policyOptions_.mlfqLevels = std::max(1, levels);
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::setRandomSeed(uint64_t seed) {
+    LockGuard guard(lock_);
+    policyOptions_.seed = seed;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::setClockMode(ClockMode mode) {
+    if (running_ || mode == clock_.mode()) return;
+    if (executionMode_ == ExecutionMode::TASKS) return; // tasks run on the wall clock
     {
-        SpinlockGuard guard(lock_);
-        allProcesses_.push_back(proc);
-        readyQueue_.enqueue(proc);
-        proc->setState(ProcessState::READY);
+        LockGuard guard(lock_);
+        settleSlices(); // timed on the old clock
     }
-    updateStats();
+    clock_.setMode(mode); // continues from the current time, so arrival times and timers stay meaningful
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+ClockMode BasicScheduler<Policy, Clock, StatsSink>::getClockMode() const { return clock_.mode(); }
+
+template <typename Policy, typename Clock, typename StatsSink>
+int BasicScheduler<Policy, Clock, StatsSink>::getCpuCount() const { return static_cast<int>(cpus_.size()); }
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::setExecutionMode(ExecutionMode mode) {
+    if (running_) return;
+    if (mode == ExecutionMode::TASKS) {
+        setClockMode(ClockMode::REAL_TIME);
+        if (clock_.mode() != ClockMode::REAL_TIME) return; // Clock cannot follow the wall clock
+    }
+    LockGuard guard(lock_); // submitTask() reads the mode under it
+    if (mode == ExecutionMode::TASKS) {
+        settleSlices(); // workers run their own slices
+    } else {
+        for (const Task& task : tasks_) {
+            if (task) return; // queued tasks only ever run on the workers
+        }
+    }
+    executionMode_ = mode;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+ExecutionMode BasicScheduler<Policy, Clock, StatsSink>::getExecutionMode() const { return executionMode_; }
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::setPolicy(SchedulingPolicyType type) {
+    if constexpr (std::is_same_v<Policy, DynamicPolicy>) {
+        LockGuard guard(lock_);
+        if (type == cpus_[0]->policy.type()) return;
+        // Drain every old queue before the reset: CFS and MLFQ find their entries by
+        // the vruntime and level columns, so they cannot dequeue once those are zeroed
+        std::vector<std::vector<ProcessHandle>> queued(cpus_.size());
+        for (int i = 0; i < getCpuCount(); ++i) {
+            auto old = cpus_[i]->policy.replace(makeSchedulingPolicy(type, table_, policyOptions(i)));
+            for (ProcessHandle proc = old->dequeue(); proc != INVALID_PROCESS; proc = old->dequeue()) {
+                queued[i].push_back(proc);
+            }
+        }
+        table_.resetPolicyState(); // vruntime and levels mean something else to the new policy
+        for (int i = 0; i < getCpuCount(); ++i) {
+            configurePolicy(i);
+            for (ProcessHandle proc : queued[i]) {
+                cpus_[i]->policy.enqueue(proc);
+            }
+        }
+    } else {
+        (void)type; // fixed at compile time
+    }
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+SchedulingPolicyType BasicScheduler<Policy, Clock, StatsSink>::getPolicy() const { return cpus_[0]->policy.type(); }
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::setRetiredHistoryLimit(size_t count) {
+    LockGuard guard(lock_);
+    table_.setRetiredHistoryLimit(count);
+    snapshotDirty_ = true;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+PolicyOptions BasicScheduler<Policy, Clock, StatsSink>::policyOptions(int cpu) const {
+    PolicyOptions options = policyOptions_;
+    options.seed += cpu; // distinct but reproducible lottery draws per CPU
+    return options;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::configurePolicy(int cpu) {
+    Policy& policy = cpus_[cpu]->policy;
+    policy.setTimeQuantum(timeQuantumMs_);
+    policy.setAgingFactor(agingFactorSec_);
+    policy.tick(getCurrentTime());
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+long long BasicScheduler<Policy, Clock, StatsSink>::getCurrentTime() const {
+    return clock_.now();
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+int BasicScheduler<Policy, Clock, StatsSink>::createProcess(const std::string& name, int priority, int burstTime) {
+    int pid;
+    {
+        LockGuard guard(lock_);
+        drainCommands();
+        pid = spawnProcess(name, priority, burstTime);
+        updateStats();
+    }
+    signalWork();
+    return pid;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+int BasicScheduler<Policy, Clock, StatsSink>::createProcess(const std::string& name, int priority, const RealTimeParams& rt) {
+    int pid;
+    {
+        LockGuard guard(lock_);
+        drainCommands();
+        pid = spawnRealTimeProcess(name, priority, rt);
+        updateStats();
+    }
+    if (pid > 0) signalWork();
+    return pid;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+int BasicScheduler<Policy, Clock, StatsSink>::spawnProcess(const std::string& name, int priority, int burstTime) {
+    ProcessHandle proc = newProcess(name, priority, burstTime, getCurrentTime());
+    admitProcess(proc);
+    return table_.pid(proc);
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+int BasicScheduler<Policy, Clock, StatsSink>::spawnRealTimeProcess(const std::string& name, int priority, const RealTimeParams& rt) {
+    ProcessHandle proc = newRealTimeProcess(name, priority, rt, getCurrentTime());
+    if (proc == INVALID_PROCESS) return -1;
+    admitProcess(proc);
+    return table_.pid(proc);
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+int BasicScheduler<Policy, Clock, StatsSink>::scheduleArrival(const std::string& name, int priority, int burstTime, long long arrivalMs) {
+    if (arrivalMs <= getCurrentTime()) {
+        return createProcess(name, priority, burstTime);
+    }
+
+    int pid;
+    {
+        LockGuard guard(lock_);
+        drainCommands();
+        ProcessHandle proc = newProcess(name, priority, burstTime, arrivalMs);
+        pushEvent(arrivalMs, SchedulerEventType::ARRIVAL, proc);
+        pid = table_.pid(proc);
+    }
+    signalWork(); // an idle loop recomputes its wake-up time
+    return pid;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+int BasicScheduler<Policy, Clock, StatsSink>::scheduleArrival(const std::string& name, int priority, const RealTimeParams& rt,
+                               long long arrivalMs) {
+    if (arrivalMs <= getCurrentTime()) {
+        return createProcess(name, priority, rt);
+    }
+
+    int pid;
+    {
+        LockGuard guard(lock_);
+        drainCommands();
+        ProcessHandle proc = newRealTimeProcess(name, priority, rt, arrivalMs);
+        if (proc == INVALID_PROCESS) return -1;
+        pushEvent(arrivalMs, SchedulerEventType::ARRIVAL, proc);
+        pid = table_.pid(proc);
+    }
+    signalWork();
+    return pid;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+int BasicScheduler<Policy, Clock, StatsSink>::submitTask(const std::string& name, int priority, Task task) {
+    int pid;
+    {
+        LockGuard guard(lock_);
+        // The simulation would run a task's zero-length burst and retire it unrun
+        if (executionMode_ != ExecutionMode::TASKS || !task) return -1;
+        drainCommands();
+        ProcessHandle proc = newProcess(name, priority, 0, getCurrentTime());
+        if (tasks_.size() < table_.size()) tasks_.resize(table_.size());
+        tasks_[proc] = std::move(task);
+        admitProcess(proc);
+        updateStats();
+        pid = table_.pid(proc);
+    }
+    signalWork();
+    return pid;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+ProcessHandle BasicScheduler<Policy, Clock, StatsSink>::newProcess(const std::string& name, int priority, int burstTime, long long arrivalMs) {
+    int pid = nextPid_++;
+    ProcessHandle proc = table_.add(pid, name, priority, burstTime, static_cast<int>(arrivalMs));
+    processIndex_.insert(pid, proc);
     return proc;
 }
 
-void Scheduler::terminateProcess(int pid) {
-    SpinlockGuard guard(lock_);
-    for (auto& p : allProcesses_) {
-        if (p->getPid() == pid) {
-            p->setState(ProcessState::TERMINATED);
-            break;
+template <typename Policy, typename Clock, typename StatsSink>
+ProcessHandle BasicScheduler<Policy, Clock, StatsSink>::newRealTimeProcess(const std::string& name, int priority, const RealTimeParams& rt,
+                                            long long arrivalMs) {
+    if (rt.kind == RealTimeKind::NONE || rt.periodMs <= 0 || rt.wcetMs <= 0 ||
+        rt.deadlineMs < 0 || rt.jobs <= 0) {
+        return INVALID_PROCESS;
+    }
+    // Utilization bound: exact for EDF on one CPU, necessary but not sufficient on several
+    long long density = rt.densityPpm();
+    if (realTimeDensityPpm_ + density > getCpuCount() * 1000000LL) {
+        deadlineStats_.rejected++;
+        return INVALID_PROCESS;
+    }
+    realTimeDensityPpm_ += density;
+
+    ProcessHandle proc = newProcess(name, priority, rt.wcetMs, arrivalMs);
+    table_.setRealTime(proc, rt, arrivalMs);
+    return proc;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::admitProcess(ProcessHandle proc) {
+    if (table_.state(proc) != ProcessState::NEW) return; // killed before it arrived
+    table_.setCpu(proc, leastLoadedCpu());
+    makeReady(proc, getCurrentTime());
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::makeReady(ProcessHandle proc, long long now) {
+    if (isCurrent(proc)) {
+        // A task that waited ended its wait before its worker got it back: it never left
+        // the CPU, and queueing it would let another worker run the same process
+        table_.setState(proc, ProcessState::RUNNING, now);
+        return;
+    }
+    int cpu = table_.cpu(proc);
+    if (cpu < 0) {
+        cpu = leastLoadedCpu();
+        table_.setCpu(proc, cpu);
+    }
+    table_.setState(proc, ProcessState::READY, now);
+    cpus_[cpu]->policy.enqueue(proc);
+    queued_++;
+    preemptOnArrival(cpu, proc);
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::unqueue(ProcessHandle proc) {
+    int cpu = table_.cpu(proc);
+    if (cpu >= 0 && cpus_[cpu]->policy.remove(proc)) {
+        queued_--;
+    }
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+bool BasicScheduler<Policy, Clock, StatsSink>::isCurrent(ProcessHandle proc) const {
+    int cpu = table_.cpu(proc);
+    return cpu >= 0 && cpus_[cpu]->current == proc;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+int BasicScheduler<Policy, Clock, StatsSink>::leastLoadedCpu() const {
+    int best = 0;
+    size_t bestLoad = SIZE_MAX;
+    for (size_t i = 0; i < cpus_.size(); ++i) {
+        const Cpu& cpu = *cpus_[i];
+        size_t load = cpu.policy.size() + (cpu.current != INVALID_PROCESS ? 1 : 0);
+        if (load < bestLoad) {
+            best = static_cast<int>(i);
+            bestLoad = load;
         }
     }
+    return best;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+ProcessHandle BasicScheduler<Policy, Clock, StatsSink>::steal(int thief) {
+    if (queued_ == 0) return INVALID_PROCESS;
+
+    // Take the best process from the longest run queue
+    Cpu* victim = nullptr;
+    for (auto& cpu : cpus_) {
+        if (!victim || cpu->policy.size() > victim->policy.size()) {
+            victim = cpu.get();
+        }
+    }
+    ProcessHandle proc = victim->policy.dequeue();
+    if (proc == INVALID_PROCESS) return INVALID_PROCESS;
+
+    queued_--;
+    table_.setCpu(proc, thief);
+    cpus_[thief]->migrations++;
+    return proc;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::terminateProcess(int pid) {
+    LockGuard guard(lock_);
+    drainCommands();
+    killProcess(pid);
     updateStats();
 }
 
-void Scheduler::blockProcess(int pid) {
-    SpinlockGuard guard(lock_);
-    for (auto& p : allProcesses_) {
-        if (p->getPid() == pid && p->getState() == ProcessState::RUNNING) {
-            p->setState(ProcessState::WAITING);
-            break;
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::killProcess(int pid) {
+    if (auto* entry = processIndex_.find(pid)) {
+        ProcessHandle p = *entry;
+        // Drop it from the ready queue and timers so it can never be dispatched again
+        long long now = getCurrentTime();
+        unqueue(p);
+        cancelWakeup(pid);
+        if (table_.state(p) != ProcessState::NEW) {
+            table_.setTurnaroundTime(p, static_cast<int>(now) - table_.arrivalTime(p));
+        }
+        table_.setState(p, ProcessState::TERMINATED, now);
+        processIndex_.erase(pid);
+        // The running process is still referenced until its slice ends
+        if (!isCurrent(p)) {
+            retireProcess(p);
         }
     }
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::blockProcess(int pid) {
+    LockGuard guard(lock_);
+    drainCommands();
+    blockRunning(pid);
     updateStats();
 }
 
-void Scheduler::unblockProcess(int pid) {
-    SpinlockGuard guard(lock_);
-    for (auto& p : allProcesses_) {
-        if (p->getPid() == pid && p->getState() == ProcessState::WAITING) {
-            p->setState(ProcessState::READY);
-            readyQueue_.enqueue(p);
-            break;
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::blockRunning(int pid) {
+    auto* entry = processIndex_.find(pid);
+    if (entry && table_.state(*entry) == ProcessState::RUNNING) {
+        ProcessHandle p = *entry;
+        if (vacateCpu(p, getCurrentTime())) {
+            table_.setState(p, ProcessState::WAITING);
+        }
+    }
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::unblockProcess(int pid) {
+    {
+        LockGuard guard(lock_);
+        drainCommands();
+        wakeBlocked(pid);
+        updateStats();
+    }
+    signalWork();
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::wakeBlocked(int pid) {
+    auto* entry = processIndex_.find(pid);
+    if (entry && table_.state(*entry) == ProcessState::WAITING) {
+        cancelWakeup(pid);
+        makeReady(*entry, getCurrentTime());
+    }
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::waitProcess(int pid, int ms) {
+    LockGuard guard(lock_);
+    drainCommands();
+    auto* entry = processIndex_.find(pid);
+    if (entry) {
+        ProcessHandle p = *entry;
+        long long now = getCurrentTime();
+        if (table_.state(p) == ProcessState::READY) {
+            unqueue(p);
+            table_.setState(p, ProcessState::WAITING, now);
+            sleepUntil(p, now + ms);
+        } else if (table_.state(p) == ProcessState::RUNNING && vacateCpu(p, now)) {
+            table_.setState(p, ProcessState::WAITING, now);
+            sleepUntil(p, now + ms);
         }
     }
     updateStats();
 }
 
-void Scheduler::start() {
-    if (running_) return;
+template <typename Policy, typename Clock, typename StatsSink>
+std::future<int> BasicScheduler<Policy, Clock, StatsSink>::createProcessAsync(const std::string& name, int priority, int burstTime) {
+    SchedulerCommand command;
+    command.type = SchedulerCommandType::CREATE;
+    command.name = name;
+    command.priority = priority;
+    command.burstTime = burstTime;
+    std::future<int> pid = command.result.emplace().get_future();
+    submitCommand(std::move(command));
+    return pid;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+std::future<int> BasicScheduler<Policy, Clock, StatsSink>::createProcessAsync(const std::string& name, int priority, const RealTimeParams& rt) {
+    SchedulerCommand command;
+    command.type = SchedulerCommandType::CREATE_REAL_TIME;
+    command.name = name;
+    command.priority = priority;
+    command.realTime = rt;
+    std::future<int> pid = command.result.emplace().get_future();
+    submitCommand(std::move(command));
+    return pid;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::terminateProcessAsync(int pid) {
+    SchedulerCommand command;
+    command.type = SchedulerCommandType::TERMINATE;
+    command.pid = pid;
+    submitCommand(std::move(command));
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::blockProcessAsync(int pid) {
+    SchedulerCommand command;
+    command.type = SchedulerCommandType::BLOCK;
+    command.pid = pid;
+    submitCommand(std::move(command));
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::unblockProcessAsync(int pid) {
+    SchedulerCommand command;
+    command.type = SchedulerCommandType::UNBLOCK;
+    command.pid = pid;
+    submitCommand(std::move(command));
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::submitCommand(SchedulerCommand command) {
+    commands_.push(std::move(command));
+    // Only the first command of a batch wakes an idle worker
+    if (pendingCommands_.fetch_add(1, std::memory_order_acq_rel) == 0) {
+        signalWork();
+    }
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::drainCommands() {
+    if (pendingCommands_.load(std::memory_order_acquire) == 0) return;
+
+    int applied = 0;
+    SchedulerCommand command;
+    while (commands_.pop(command)) {
+        int pid = applyCommand(command);
+        if (command.result) command.result->set_value(pid);
+        command.result.reset();
+        applied++;
+    }
+    pendingCommands_.fetch_sub(applied, std::memory_order_acq_rel);
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+int BasicScheduler<Policy, Clock, StatsSink>::applyCommand(SchedulerCommand& command) {
+    switch (command.type) {
+        case SchedulerCommandType::CREATE:
+            return spawnProcess(command.name, command.priority, command.burstTime);
+        case SchedulerCommandType::CREATE_REAL_TIME:
+            return spawnRealTimeProcess(command.name, command.priority, command.realTime);
+        case SchedulerCommandType::TERMINATE:
+            killProcess(command.pid);
+            break;
+        case SchedulerCommandType::BLOCK:
+            blockRunning(command.pid);
+            break;
+        case SchedulerCommandType::UNBLOCK:
+            wakeBlocked(command.pid);
+            break;
+    }
+    return command.pid;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::start() {
+    if (running_) {
+        resume();
+        return;
+    }
     running_ = true;
     paused_ = false;
-    std::thread(&Scheduler::schedulerLoop, this).detach();
+    if (executionMode_ == ExecutionMode::TASKS) {
+        for (int cpu = 0; cpu < getCpuCount(); ++cpu) {
+            workers_.emplace_back(&BasicScheduler::workerLoop, this, cpu);
+        }
+        return;
+    }
+    schedulerThread_ = std::thread(&BasicScheduler::schedulerLoop, this);
 }
 
-void Scheduler::pause() { paused_ = true; }
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::pause() { paused_ = true; }
 
-void Scheduler::stop() { running_ = false; }
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::resume() {
+    paused_ = false;
+    signalWork(); // the loops block while paused
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::stop() {
+    running_ = false;
+    signalWork();
+    joinUnlessSelf(schedulerThread_);
+    for (auto& worker : workers_) {
+        joinUnlessSelf(worker);
+    }
+    workers_.clear();
 
-void Scheduler::setStatsCallback(StatsCallback cb) { statsCallback_ = cb; }
+    if constexpr (StatsSink::LIVE) {
+        LockGuard guard(lock_);
+        flushSnapshot();
+    }
+}
 
-void Scheduler::schedulerLoop() {
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::signalWork() {
+    {
+        std::lock_guard<std::mutex> guard(workMutex_);
+        workSignal_++;
+    }
+    workCv_.notify_all();
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+uint64_t BasicScheduler<Policy, Clock, StatsSink>::workSeen() {
+    std::lock_guard<std::mutex> guard(workMutex_);
+    return workSignal_;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+long long BasicScheduler<Policy, Clock, StatsSink>::waitUntil(uint64_t seen, long long deadlineMs) {
+    // A command whose producer had not finished linking it when the queue was
+    // drained carries no further signal; come back for it shortly. The retry is
+    // on the wall clock: a virtual deadline says nothing about when that is.
+    bool retry = pendingCommands_.load(std::memory_order_acquire) > 0;
+    auto woken = [&] { return !running_ || workSignal_ != seen; };
+    std::unique_lock<std::mutex> guard(workMutex_);
+    if (deadlineMs == NO_WAKEUP && !retry) {
+        workCv_.wait(guard, woken);
+        return -1;
+    }
+    // An absolute steady_clock deadline (CLOCK_MONOTONIC, TIMER_ABSTIME underneath):
+    // the time spent working before the wait never pushes the wake-up back
+    auto soon = std::chrono::steady_clock::now() + std::chrono::milliseconds(1);
+    auto deadline = deadlineMs == NO_WAKEUP ? soon : clock_.wallTime(deadlineMs);
+    if (retry) deadline = std::min(deadline, soon);
+    if (workCv_.wait_until(guard, deadline, woken)) return -1;
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - deadline).count();
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::runToCompletion() {
+    if (running_ || clock_.mode() != ClockMode::VIRTUAL) return;
+    running_ = true;
+    paused_ = false;
+    while (running_ && processNextEvent()) {}
+    running_ = false;
+
+    if constexpr (StatsSink::LIVE) {
+        LockGuard guard(lock_);
+        flushSnapshot();
+    }
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::setStatsCallback(StatsCallback cb) {
+    if constexpr (StatsSink::LIVE) {
+        statsSink_.setCallback(std::move(cb));
+    } else {
+        (void)cb;
+    }
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::schedulerLoop() {
+    if (clock_.mode() == ClockMode::VIRTUAL) {
+        eventLoop();
+    } else {
+        realTimeLoop();
+    }
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::realTimeLoop() {
+    // Tickless: each pass ends the slices that are due, starts new ones on free CPUs
+    // and sleeps until the earliest slice end, wake-up timer or arrival
+    bool waited = false;
+    long long overshootUs = -1; // of the last wake-up; recorded under the lock
     while (running_) {
-        if (paused_) { std::this_thread::sleep_for(std::chrono::milliseconds(10)); continue; }
-        
-        selectNextProcess();
-        
-        if (currentProcess_) {
-            currentProcess_->execute(timeQuantumMs_);
-            
-            // Simulate I/O blocking: 10% chance (less aggressive)
-            ioSimulationCounter_++;
-            if (ioSimulationCounter_ % 10 == 0 && 
-                currentProcess_->getState() != ProcessState::TERMINATED &&
-                currentProcess_->getRemainingTime() > 500) { // Only block if enough time left
-                
-                // Block current process for I/O
-                int currentPid = currentProcess_->getPid();
-                currentProcess_->setState(ProcessState::WAITING);
-                
-                // Add to blocked list with short I/O time (100-300ms)
-                int ioTime = 100 + (rand() % 200);
-                {
-                    SpinlockGuard guard(lock_);
-                    blockedProcesses_.push_back({currentProcess_, ioTime});
-                }
-                
-                currentProcess_ = nullptr; // Release CPU
+        uint64_t seen = workSeen();
+        if (paused_) {
+            waitUntil(seen, NO_WAKEUP);
+            continue;
+        }
+
+        long long deadline;
+        {
+            LockGuard guard(lock_);
+            if (waited && overshootUs < 0) {
+                wakeupStats_.signalledWakeups++;
+            } else if (waited) {
+                wakeupStats_.timedWakeups++;
+                wakeupStats_.overshootUs.record(overshootUs);
             }
-            else if (currentProcess_->getState() == ProcessState::TERMINATED) {
-                currentProcess_ = nullptr;
+
+            drainCommands();
+            long long now = getCurrentTime();
+            admitDueArrivals();
+            // Unblock processes whose I/O completed; only expiring timers are touched
+            wakeExpiredTimers(now);
+            for (int cpu = 0; cpu < getCpuCount(); ++cpu) {
+                Cpu& c = *cpus_[cpu];
+                long long start = now;
+                if (c.sliceInFlight && now >= c.sliceEnd) {
+                    c.sliceInFlight = false;
+                    if (c.current != INVALID_PROCESS) {
+                        runSlice(cpu, static_cast<int>(c.sliceEnd - c.sliceStart));
+                    }
+                    // The CPU was busy until sliceEnd: the next slice starts there, so
+                    // wake-up overshoot does not add up to drift (unless a quantum behind)
+                    if (now - c.sliceEnd < timeQuantumMs_) start = c.sliceEnd;
+                }
+                dispatchSlice(cpu, start);
             }
+
+            updateStats();
+            flushSnapshot();
+            deadline = nextWakeup();
         }
-        
-        // Check blocked processes and unblock if I/O complete
-        {
-            SpinlockGuard guard(lock_);
-            auto it = blockedProcesses_.begin();
-            while (it != blockedProcesses_.end()) {
-                it->second -= timeQuantumMs_; // Decrease I/O time
-                
-                if (it->second <= 0) {
-                    // I/O complete, unblock process
-                    auto proc = it->first;
-                    proc->setState(ProcessState::READY);
-                    readyQueue_.enqueue(proc);
-                    it = blockedProcesses_.erase(it);
+
+        overshootUs = waitUntil(seen, deadline);
+        waited = true;
+    }
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::workerLoop(int cpu) {
+    Cpu& c = *cpus_[cpu];
+    while (running_) {
+        uint64_t seen = workSeen();
+        ProcessHandle proc = INVALID_PROCESS;
+        long long wakeAt = NO_WAKEUP; // paused: until resume()
+        Task task;
+        int pid = 0;
+        int slice = 0;
+        int simulatedSlice = 0;
+        if (!paused_) {
+            LockGuard guard(lock_);
+            drainCommands();
+            admitDueArrivals();
+            wakeExpiredTimers(getCurrentTime());
+            selectNextProcess(cpu);
+            proc = c.current;
+            if (proc != INVALID_PROCESS) {
+                pid = table_.pid(proc);
+                slice = sliceLength(cpu);
+                if (proc < tasks_.size() && tasks_[proc]) {
+                    task = std::move(tasks_[proc]); // run it outside the lock
                 } else {
-                    ++it;
+                    simulatedSlice = std::min(slice, table_.remainingTime(proc));
                 }
+            } else {
+                flushSnapshot(); // about to park
+                wakeAt = nextWakeup();
             }
         }
-        
-        applyAging();
+
+        if (proc == INVALID_PROCESS) {
+            // Idle: park until new work is signalled or the next timer or arrival is due
+            waitUntil(seen, wakeAt);
+            continue;
+        }
+
+        auto begin = std::chrono::steady_clock::now();
+        TaskStatus status = TaskStatus::YIELD;
+        if (task) {
+            TaskContext context(pid, begin + std::chrono::milliseconds(slice));
+            status = task(context);
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(simulatedSlice));
+        }
+        auto elapsed = std::chrono::steady_clock::now() - begin;
+
+        {
+            LockGuard guard(lock_);
+            long long elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+            c.busyTimeUs += elapsedUs;
+            c.policy.charge(proc, static_cast<int>(elapsedUs / 1000));
+            if (!task && table_.state(proc) == ProcessState::RUNNING) {
+                table_.execute(proc, simulatedSlice);
+                if (table_.remainingTime(proc) == 0) status = TaskStatus::DONE;
+            }
+            finishTaskSlice(cpu, status, std::move(task));
+            updateStats();
+        }
+        signalWork(); // a requeued task may be stolen by an idle worker
+    }
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::finishTaskSlice(int cpu, TaskStatus status, Task task) {
+    Cpu& c = *cpus_[cpu];
+    ProcessHandle proc = c.current;
+    c.current = INVALID_PROCESS;
+    long long now = getCurrentTime();
+    int pid = table_.pid(proc);
+    ProcessState state = table_.state(proc);
+
+    if (status == TaskStatus::DONE || state == ProcessState::TERMINATED) {
+        if (!task && table_.isRealTime(proc) && table_.remainingTime(proc) == 0 && completeJob(proc, now)) {
+            return; // next job pending
+        }
+        if (status == TaskStatus::DONE && processIndex_.find(pid)) { // not killed meanwhile
+            table_.setState(proc, ProcessState::TERMINATED, now);
+            table_.setTurnaroundTime(proc, static_cast<int>(now) - table_.arrivalTime(proc));
+            processIndex_.erase(pid);
+        }
+        retireProcess(proc);
+        return;
+    }
+
+    if (task) {
+        tasks_[proc] = std::move(task);
+    }
+    if (state == ProcessState::RUNNING) {
+        makeReady(proc, now); // yielded: aging restarts from now
+    }
+    // WAITING: blocked or sleeping until unblockProcess() or its timer
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::eventLoop() {
+    while (running_) {
+        uint64_t seen = workSeen();
+        if (paused_) {
+            waitUntil(seen, NO_WAKEUP);
+            continue;
+        }
+
+        if (!processNextEvent()) {
+            {
+                LockGuard guard(lock_);
+                flushSnapshot();
+            }
+            // Simulation drained: wait for createProcess() to supply more work
+            waitUntil(seen, NO_WAKEUP);
+        }
+    }
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+bool BasicScheduler<Policy, Clock, StatsSink>::processNextEvent() {
+    LockGuard guard(lock_);
+    drainCommands();
+    for (int cpu = 0; cpu < getCpuCount(); ++cpu) {
+        dispatchSlice(cpu, clock_.now());
+    }
+
+    long long timerDue = wakeupTimers_.nextExpiryBound();
+    if (events_.empty() && timerDue < 0) return false;
+
+    // Jump the clock straight to the next event; nothing happens in between
+    if (timerDue >= 0 && (events_.empty() || timerDue <= events_.top().time)) {
+        clock_.advanceTo(std::max(clock_.now(), timerDue));
+        eventsProcessed_ += wakeExpiredTimers(clock_.now());
         updateStats();
-        std::this_thread::sleep_for(std::chrono::milliseconds(timeQuantumMs_));
+        return true;
+    }
+
+    SchedulerEvent ev = events_.top();
+    events_.pop();
+    clock_.advanceTo(ev.time);
+    wakeExpiredTimers(ev.time); // keeps the wheel in step with the clock; nothing is due
+
+    switch (ev.type) {
+        case SchedulerEventType::ARRIVAL:
+            if (!isStale(ev)) admitProcess(ev.process);
+            break;
+        case SchedulerEventType::QUANTUM_EXPIRY: {
+            Cpu& c = *cpus_[ev.cpu];
+            if (!c.sliceInFlight || ev.seq != c.sliceEvent) break; // slice was preempted
+            c.sliceInFlight = false;
+            if (c.current != INVALID_PROCESS) {
+                runSlice(ev.cpu, static_cast<int>(ev.time - c.sliceStart));
+            }
+            break;
+        }
     }
+
+    eventsProcessed_++;
+    updateStats();
+    return true;
 }
 
-void Scheduler::selectNextProcess() {
-    if (!currentProcess_ || currentProcess_->getState() == ProcessState::TERMINATED) {
-        SpinlockGuard guard(lock_);
-        if (!readyQueue_.empty()) {
-            currentProcess_ = readyQueue_.dequeue();
-            currentProcess_->setState(ProcessState::RUNNING);
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::dispatchSlice(int cpu, long long start) {
+    Cpu& c = *cpus_[cpu];
+    if (c.sliceInFlight) return;
+
+    selectNextProcess(cpu);
+    if (c.current == INVALID_PROCESS) return;
+
+    // The slice ends early if the process finishes inside its quantum
+    int slice = std::min(sliceLength(cpu), table_.remainingTime(c.current));
+    c.sliceStart = start;
+    c.sliceEnd = c.sliceStart + slice;
+    if (clock_.mode() == ClockMode::VIRTUAL) { // the real-time loop sleeps until sliceEnd itself
+        c.sliceEvent = nextEventSeq_;
+        pushEvent(c.sliceEnd, SchedulerEventType::QUANTUM_EXPIRY, c.current, cpu);
+    }
+    c.sliceInFlight = true;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::settleSlices() {
+    // Account the part already run; a pending QUANTUM_EXPIRY becomes stale
+    long long now = clock_.now();
+    for (int cpu = 0; cpu < getCpuCount(); ++cpu) {
+        Cpu& c = *cpus_[cpu];
+        if (!c.sliceInFlight) continue;
+        c.sliceInFlight = false;
+        if (c.current != INVALID_PROCESS) {
+            runSlice(cpu, static_cast<int>(std::clamp(now - c.sliceStart, 0LL, c.sliceEnd - c.sliceStart)));
         }
     }
 }
 
-void Scheduler::contextSwitch(std::shared_ptr<Process> next) {
-    // Not used in this simple implementation; placeholder for future extension
-    (void)next;
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::runSlice(int cpu, int ms) {
+    Cpu& c = *cpus_[cpu];
+    int ran = table_.execute(c.current, ms);
+    c.busyTimeUs += ran * 1000LL;
+    c.policy.charge(c.current, ran);
+    endSlice(cpu);
 }
 
-void Scheduler::applyAging() {
-    SpinlockGuard guard(lock_);
-    readyQueue_.applyAging(agingFactorSec_);
+template <typename Policy, typename Clock, typename StatsSink>
+int BasicScheduler<Policy, Clock, StatsSink>::sliceLength(int cpu) const {
+    const Cpu& c = *cpus_[cpu];
+    return c.policy.timeSlice(c.current, timeQuantumMs_);
 }
 
-void Scheduler::updateStats() {
-    static auto startTime = std::chrono::steady_clock::now();
-    auto now = std::chrono::steady_clock::now();
-    int currentTime = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime).count();
-    
-    // Simple stats calculation
-    SchedulerStats newStats{};
-    newStats.totalProcesses = static_cast<int>(allProcesses_.size());
-    int running = 0, ready = 0, waiting = 0, terminated = 0;
-    int totalWait = 0, totalTurnaround = 0;
-    
-    for (const auto& p : allProcesses_) {
-        // Update wait time for READY processes
-        if (p->getState() == ProcessState::READY) {
-            p->waitTime += timeQuantumMs_;
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::preemptOnArrival(int cpu, ProcessHandle arrived) {
+    // Real-time ticks and task slices are indivisible; they preempt at slice end only
+    Cpu& c = *cpus_[cpu];
+    if (clock_.mode() != ClockMode::VIRTUAL || !c.sliceInFlight) return;
+    long long now = clock_.now();
+    if (now >= c.sliceEnd || table_.state(c.current) != ProcessState::RUNNING) return;
+
+    // Account the part of the slice already run so the policy sees current figures
+    int ran = table_.execute(c.current, static_cast<int>(now - c.sliceStart));
+    c.busyTimeUs += ran * 1000LL;
+    c.policy.charge(c.current, ran);
+    c.sliceStart = now;
+    if (!c.policy.preemptOnArrival(c.current, arrived)) return;
+
+    c.sliceInFlight = false; // the pending QUANTUM_EXPIRY is now stale
+    requeueCurrent(cpu, now);
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::requeueCurrent(int cpu, long long now) {
+    Cpu& c = *cpus_[cpu];
+    ProcessHandle preempted = c.current;
+    c.current = INVALID_PROCESS;
+    makeReady(preempted, now); // stays on this CPU
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+long long BasicScheduler<Policy, Clock, StatsSink>::nextWakeup() const {
+    long long due = wakeupTimers_.nextExpiryBound();
+    auto earlier = [&due](long long time) {
+        if (due == NO_WAKEUP || time < due) due = time;
+    };
+    if (!events_.empty()) earlier(events_.top().time);
+    for (const auto& cpu : cpus_) {
+        if (cpu->sliceInFlight) earlier(cpu->sliceEnd);
+    }
+    return due;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+bool BasicScheduler<Policy, Clock, StatsSink>::vacateCpu(ProcessHandle proc, long long now) {
+    if (executionMode_ == ExecutionMode::TASKS || !isCurrent(proc)) return true;
+    int cpu = table_.cpu(proc);
+    Cpu& c = *cpus_[cpu];
+    if (c.sliceInFlight) {
+        c.sliceInFlight = false; // a pending QUANTUM_EXPIRY becomes stale
+        int ran = table_.execute(proc, static_cast<int>(std::clamp(now - c.sliceStart, 0LL, c.sliceEnd - c.sliceStart)));
+        c.busyTimeUs += ran * 1000LL;
+        c.policy.charge(proc, ran);
+        if (table_.state(proc) != ProcessState::RUNNING) {
+            endSlice(cpu); // finished within the part already run
+            return false;
         }
-        
-        // Update turnaround time for non-terminated processes
-        if (p->getState() != ProcessState::TERMINATED) {
-            p->turnaroundTime = currentTime - p->arrivalTime;
+    }
+    c.current = INVALID_PROCESS;
+    return true;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::admitDueArrivals() {
+    long long now = getCurrentTime();
+    while (!events_.empty() && events_.top().time <= now) {
+        SchedulerEvent ev = events_.top();
+        events_.pop();
+        if (ev.type == SchedulerEventType::ARRIVAL && !isStale(ev)) {
+            admitProcess(ev.process);
         }
+    }
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::pushEvent(long long time, SchedulerEventType type, ProcessHandle proc, int cpu) {
+    SchedulerEvent ev;
+    ev.time = time;
+    ev.seq = nextEventSeq_++;
+    ev.type = type;
+    ev.process = proc;
+    ev.pid = table_.pid(proc);
+    ev.cpu = cpu;
+    events_.push(ev);
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+bool BasicScheduler<Policy, Clock, StatsSink>::isStale(const SchedulerEvent& ev) const {
+    return !table_.isLive(ev.process) || table_.pid(ev.process) != ev.pid;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::endSlice(int cpu) {
+    ProcessHandle& current = cpus_[cpu]->current;
+    ProcessState state = table_.state(current);
+
+    // Simulate I/O blocking: 10% chance (less aggressive)
+    ioSimulationCounter_++;
+    if (ioSimulationCounter_ % 10 == 0 &&
+        state == ProcessState::RUNNING &&
+        table_.remainingTime(current) > 500 && // Only block if enough time left
+        !table_.isRealTime(current)) {         // real-time jobs are CPU-bound
         
-        switch (p->getState()) {
-            case ProcessState::RUNNING: running++; break;
-            case ProcessState::READY: ready++; break;
-            case ProcessState::WAITING: waiting++; break;
-            case ProcessState::TERMINATED: terminated++; break;
-            default: break;
+        // Block current process for I/O with short I/O time (100-300ms)
+        table_.setState(current, ProcessState::WAITING);
+        blockForIo(current, 100 + (rand() % 200));
+        current = INVALID_PROCESS; // Release CPU
+    }
+    else if (state == ProcessState::RUNNING) {
+        cpus_[cpu]->policy.tick(getCurrentTime());
+        if (cpus_[cpu]->policy.preemptAtSliceEnd(current)) {
+            requeueCurrent(cpu, getCurrentTime());
+        }
+    }
+    else {
+        // Finished, killed or blocked from outside during the slice
+        ProcessHandle finished = current;
+        current = INVALID_PROCESS;
+        if (state == ProcessState::TERMINATED) {
+            if (table_.remainingTime(finished) == 0) {
+                if (table_.isRealTime(finished) && completeJob(finished, getCurrentTime())) return;
+                table_.setTurnaroundTime(finished,
+                    static_cast<int>(getCurrentTime()) - table_.arrivalTime(finished));
+            }
+            processIndex_.erase(table_.pid(finished));
+            retireProcess(finished);
+        }
+    }
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+bool BasicScheduler<Policy, Clock, StatsSink>::completeJob(ProcessHandle proc, long long now) {
+    long long lateness = now - table_.deadline(proc);
+    DeadlineStats& d = deadlineStats_;
+    d.maxLatenessMs = d.jobsCompleted == 0 ? lateness : std::max(d.maxLatenessMs, lateness);
+    d.jobsCompleted++;
+    totalLatenessMs_ += lateness;
+    int bucket = 0;
+    if (lateness > 0) {
+        d.deadlineMisses++;
+        bucket = lateness < 10 ? 1 : lateness < 100 ? 2 : lateness < 1000 ? 3 : 4;
+    }
+    d.latenessBuckets[bucket]++;
+
+    // Releases follow the schedule, not the completion, so an overrun eats into the next job
+    const RealTimeParams& rt = table_.realTime(proc);
+    long long next = table_.release(proc) + rt.periodMs;
+    if (rt.kind == RealTimeKind::SPORADIC) {
+        next += rand() % (rt.periodMs / 2 + 1);
+    }
+    if (!table_.releaseJob(proc, next)) return false;
+
+    if (next <= now) {
+        makeReady(proc, now);
+    } else {
+        table_.setState(proc, ProcessState::WAITING);
+        sleepUntil(proc, next);
+    }
+    return true;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::blockForIo(ProcessHandle proc, int ioTime) {
+    sleepUntil(proc, getCurrentTime() + ioTime);
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::sleepUntil(ProcessHandle proc, long long wakeTime) {
+    int pid = table_.pid(proc);
+    cancelWakeup(pid);
+    wakeupTimerIds_.insert(pid, wakeupTimers_.schedule(wakeTime, proc));
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::cancelWakeup(int pid) {
+    if (auto* id = wakeupTimerIds_.find(pid)) {
+        wakeupTimers_.cancel(*id);
+        wakeupTimerIds_.erase(pid);
+    }
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+int BasicScheduler<Policy, Clock, StatsSink>::wakeExpiredTimers(long long now) {
+    int woken = 0;
+    wakeupTimers_.advance(now, [this, &woken](ProcessHandle proc, long long wakeTime) {
+        wakeupTimerIds_.erase(table_.pid(proc));
+        if (table_.state(proc) == ProcessState::WAITING) {
+            makeReady(proc, wakeTime); // back to the CPU it last ran on
+            woken++;
+        }
+    });
+    return woken;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::retireProcess(ProcessHandle proc) {
+    if (proc < tasks_.size()) {
+        tasks_[proc] = nullptr; // the row may be reused by a simulated process
+    }
+    if (table_.isRealTime(proc)) {
+        realTimeDensityPpm_ -= table_.realTime(proc).densityPpm(); // frees its reservation
+    }
+    table_.retire(proc);
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::selectNextProcess(int cpu) {
+    Cpu& c = *cpus_[cpu];
+    if (c.current != INVALID_PROCESS && table_.state(c.current) == ProcessState::TERMINATED) {
+        // Killed between slices; terminateProcess() left the row for us to retire
+        retireProcess(c.current);
+        c.current = INVALID_PROCESS;
+    }
+    if (c.current == INVALID_PROCESS) {
+        c.policy.tick(getCurrentTime());
+        ProcessHandle next = c.policy.dequeue();
+        if (next != INVALID_PROCESS) {
+            queued_--;
+        } else {
+            next = steal(cpu); // idle with an empty queue: pull work from the busiest CPU
+        }
+        if (next != INVALID_PROCESS) {
+            contextSwitch(cpu, next);
         }
-        totalWait += p->waitTime;
-        totalTurnaround += p->turnaroundTime;
     }
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::contextSwitch(int cpu, ProcessHandle next) {
+    Cpu& c = *cpus_[cpu];
+    c.current = next;
+    c.contextSwitches++;
+    table_.setState(next, ProcessState::RUNNING, getCurrentTime());
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::updateStats() {
+    if constexpr (StatsSink::LIVE) {
+        // The counters are republished on every change. The process list and the
+        // histograms cost O(processes) and a few KB to rebuild, so they follow at most
+        // every SNAPSHOT_INTERVAL_MS, running or not; a running loop flushes the rest
+        // when it goes idle, and while stopped or paused the readers do (catchUp())
+        snapshotDirty_ = true;
+        histogramsDirty_ = true;
+        auto now = std::chrono::steady_clock::now();
+        bool due = now - lastSnapshot_ >= std::chrono::milliseconds(SNAPSHOT_INTERVAL_MS);
+        if (due) {
+            lastSnapshot_ = now;
+            refreshHistograms();
+        }
+
+        SchedulerStats stats = collectStats();
+        statsSink_(stats);
+        publishStats(std::move(stats));
+        if (due) publishSnapshot();
+    }
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+SchedulerStats BasicScheduler<Policy, Clock, StatsSink>::collectStats() const {
+    long long currentTime = getCurrentTime();
     
-    newStats.runningProcesses = running;
-    newStats.readyProcesses = ready;
-    newStats.waitingProcesses = waiting;
-    newStats.terminatedProcesses = terminated;
-    newStats.contextSwitchCount = stats_.contextSwitchCount;
-    newStats.cpuUtilization = (running > 0) ? 100.0 : 0.0;
+    // O(1): the table keeps its totals current on every transition
+    ProcessTable::Summary summary = table_.summary(currentTime);
+    auto count = [&summary](ProcessState state) { return summary.count[static_cast<int>(state)]; };
+    
+    SchedulerStats newStats{};
+    newStats.totalProcesses = count(ProcessState::READY) + count(ProcessState::RUNNING) +
+                              count(ProcessState::WAITING) + count(ProcessState::TERMINATED);
+    newStats.runningProcesses = count(ProcessState::RUNNING);
+    newStats.readyProcesses = count(ProcessState::READY);
+    newStats.waitingProcesses = count(ProcessState::WAITING);
+    newStats.terminatedProcesses = count(ProcessState::TERMINATED);
+    newStats.simulatedTimeMs = currentTime;
+    newStats.eventsProcessed = eventsProcessed_;
+    newStats.cpuCount = getCpuCount();
+    
+    long long totalBusy = 0;
+    int minLoad = INT32_MAX, maxLoad = 0;
+    newStats.cpus.resize(cpus_.size());
+    for (size_t i = 0; i < cpus_.size(); ++i) {
+        const Cpu& cpu = *cpus_[i];
+        CpuStats& out = newStats.cpus[i];
+        out.currentPid = cpu.current != INVALID_PROCESS ? table_.pid(cpu.current) : 0;
+        out.runQueueLength = static_cast<int>(cpu.policy.size());
+        out.busyTimeMs = cpu.busyTimeUs / 1000;
+        out.utilization = currentTime > 0 ? 0.1 * cpu.busyTimeUs / currentTime : 0.0;
+        out.contextSwitches = cpu.contextSwitches;
+        out.migrations = cpu.migrations;
+        
+        int load = out.runQueueLength + (out.currentPid != 0 ? 1 : 0);
+        minLoad = std::min(minLoad, load);
+        maxLoad = std::max(maxLoad, load);
+        totalBusy += cpu.busyTimeUs;
+        newStats.contextSwitchCount += cpu.contextSwitches;
+        newStats.migrationCount += cpu.migrations;
+    }
+    newStats.loadImbalance = maxLoad - minLoad;
+    if (currentTime > 0) {
+        newStats.cpuUtilization = 0.1 * totalBusy / (static_cast<double>(currentTime) * cpus_.size());
+    }
+    
+    newStats.histograms = histograms_;
+    newStats.schedulerLock = lock_.stats();
+    newStats.deadlines = deadlineStats_;
+    newStats.deadlines.reservedUtilization = realTimeDensityPpm_ / 10000.0;
+    if (deadlineStats_.jobsCompleted > 0) {
+        newStats.deadlines.averageLatenessMs =
+            static_cast<double>(totalLatenessMs_) / deadlineStats_.jobsCompleted;
+    }
     
     if (newStats.totalProcesses > 0) {
-        newStats.averageWaitTime = static_cast<double>(totalWait) / newStats.totalProcesses;
-        newStats.averageTurnaroundTime = static_cast<double>(totalTurnaround) / newStats.totalProcesses;
+        newStats.averageWaitTime = static_cast<double>(summary.totalWait) / newStats.totalProcesses;
+        newStats.averageTurnaroundTime = static_cast<double>(summary.totalTurnaround) / newStats.totalProcesses;
     }
     
-    stats_ = newStats;
-    if (statsCallback_) {
-        statsCallback_(stats_);
+    return newStats;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+ProcessSnapshotView BasicScheduler<Policy, Clock, StatsSink>::getProcessSnapshot() const {
+    if constexpr (StatsSink::LIVE) {
+        const_cast<BasicScheduler*>(this)->catchUp(true);
+    } else {
+        LockGuard guard(const_cast<AdaptiveLock&>(lock_));
+        const_cast<BasicScheduler*>(this)->publishSnapshot();
+    }
+    return snapshot_.read();
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+std::vector<Process> BasicScheduler<Policy, Clock, StatsSink>::getProcessList() const {
+    return getProcessSnapshot()->processes;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+bool BasicScheduler<Policy, Clock, StatsSink>::publishSnapshot() {
+    bool published = snapshot_.publish([this](ProcessSnapshot& out) {
+        const auto& retired = table_.retiredHistory();
+        out.processes.assign(retired.begin(), retired.end());
+        long long now = getCurrentTime();
+        for (ProcessHandle h = 0; h < table_.size(); ++h) {
+            if (table_.isLive(h) && table_.state(h) != ProcessState::NEW) {
+                out.processes.push_back(table_.snapshot(h, now));
+            }
+        }
+        // Recycled rows are not in creation order
+        std::sort(out.processes.begin(), out.processes.end(),
+                  [](const Process& a, const Process& b) { return a.getPid() < b.getPid(); });
+        out.timeMs = now;
+        out.epoch = ++snapshotEpoch_;
+    });
+    if (published) snapshotDirty_ = false;
+    return published;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::publishStats(SchedulerStats stats) {
+    statsDirty_ = !stats_.publish([&](SchedulerStats& out) {
+        stats.generation = statsGeneration_.load(std::memory_order_relaxed) + 1;
+        out = std::move(stats);
+    });
+    if (!statsDirty_) statsGeneration_.fetch_add(1, std::memory_order_release);
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::refreshHistograms() {
+    histograms_ = std::make_shared<const StatsHistograms>(StatsHistograms{table_.latency(), wakeupStats_});
+    histogramsDirty_ = false;
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::flushStats() {
+    if constexpr (StatsSink::LIVE) {
+        if (histogramsDirty_) {
+            refreshHistograms();
+            statsDirty_ = true; // the published stats still share the old histograms
+        }
+        if (statsDirty_) publishStats(collectStats());
+    }
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::flushSnapshot() {
+    if constexpr (StatsSink::LIVE) {
+        if (snapshotDirty_) publishSnapshot();
+        flushStats();
     }
 }
 
-std::vector<std::shared_ptr<Process>> Scheduler::getProcessList() const {
-    return allProcesses_;
+template <typename Policy, typename Clock, typename StatsSink>
+void BasicScheduler<Policy, Clock, StatsSink>::catchUp(bool snapshot) {
+    // No loop is there to flush. The flags are only hints outside the lock; a
+    // scheduler started meanwhile is flushed under the lock all the same.
+    if (running_ && !paused_) return;
+    const std::atomic<bool>& dirty = snapshot ? snapshotDirty_ : histogramsDirty_;
+    if (!dirty.load(std::memory_order_acquire)) return;
+    LockGuard guard(lock_);
+    if (snapshot) {
+        flushSnapshot();
+    } else {
+        flushStats();
+    }
 }
 
-SchedulerStats Scheduler::getStats() const {
-    return stats_;
+template <typename Policy, typename Clock, typename StatsSink>
+SchedulerStats BasicScheduler<Policy, Clock, StatsSink>::getStats() const {
+    if constexpr (StatsSink::LIVE) {
+        const_cast<BasicScheduler*>(this)->catchUp(false);
+        return *stats_.read();
+    } else {
+        LockGuard guard(const_cast<AdaptiveLock&>(lock_));
+        const_cast<BasicScheduler*>(this)->refreshHistograms();
+        return collectStats(); // computed on demand
+    }
+}
+
+template <typename Policy, typename Clock, typename StatsSink>
+uint64_t BasicScheduler<Policy, Clock, StatsSink>::getStatsGeneration() const {
+    if constexpr (StatsSink::LIVE) {
+        const_cast<BasicScheduler*>(this)->catchUp(false);
+    }
+    return statsGeneration_.load(std::memory_order_acquire);
 }
 
+template class BasicScheduler<DynamicPolicy, SwitchableClock, CallbackStatsSink>;
+template class BasicScheduler<PriorityPolicy, VirtualClock, NullStatsSink>;
+template class BasicScheduler<FcfsPolicy, VirtualClock, NullStatsSink>;
+template class BasicScheduler<SjfPolicy, VirtualClock, NullStatsSink>;
+template class BasicScheduler<SrtfPolicy, VirtualClock, NullStatsSink>;
+template class BasicScheduler<RoundRobinPolicy, VirtualClock, NullStatsSink>;
+template class BasicScheduler<CfsPolicy, VirtualClock, NullStatsSink>;
+template class BasicScheduler<MlfqPolicy, VirtualClock, NullStatsSink>;
+template class BasicScheduler<EdfPolicy, VirtualClock, NullStatsSink>;
+template class BasicScheduler<StridePolicy, VirtualClock, NullStatsSink>;
+template class BasicScheduler<LotteryPolicy, VirtualClock, NullStatsSink>;
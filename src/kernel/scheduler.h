@@ -1,12 +1,65 @@
 #pragma once
 
 #include "process.h"
+#include "process_table.h"
 #include "ready_queue.h"
-#include "spinlock.h"
+#include "scheduling_policy.h"
+#include "policies.h"
+#include "adaptive_lock.h"
+#include "task.h"
+#include "pid_map.h"
+#include "timer_wheel.h"
+#include "mpsc_queue.h"
+#include "snapshot_buffer.h"
 #include <vector>
-#include <memory>
 #include <functional>
 #include <atomic>
+#include <queue>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <optional>
+#include <thread>
+
+// Per-CPU slice of SchedulerStats
+struct CpuStats {
+    int currentPid = 0;          // 0 when idle
+    int runQueueLength = 0;
+    long long busyTimeMs = 0;
+    double utilization = 0.0;    // busy share of the elapsed clock, percentage
+    int contextSwitches = 0;
+    int migrations = 0;          // processes this CPU stole from others
+};
+
+// Real-time jobs: outcome against their deadlines
+struct DeadlineStats {
+    static constexpr int LATENESS_BUCKETS = 5; // met, late by <10 ms, <100 ms, <1 s, >=1 s
+
+    long long jobsCompleted = 0;
+    long long deadlineMisses = 0;
+    int rejected = 0;                 // processes refused by the admission test
+    double reservedUtilization = 0.0; // admitted real-time demand, percentage of one CPU
+    double averageLatenessMs = 0.0;   // completion minus deadline; negative is slack
+    long long maxLatenessMs = 0;
+    long long latenessBuckets[LATENESS_BUCKETS] = {};
+};
+
+// Real-time mode: how closely the scheduler thread woke at its absolute deadlines
+struct WakeupStats {
+    uint64_t timedWakeups = 0;     // reached a deadline
+    uint64_t signalledWakeups = 0; // woken before it by new work, resume() or stop()
+    LatencyHistogram overshootUs;  // lateness of timed wake-ups, microseconds
+};
+
+// The histogram part of SchedulerStats, a few KB per histogram. It is shared and
+// immutable, so copying SchedulerStats on every change only copies a pointer.
+struct StatsHistograms {
+    LatencyStats latency; // distributions over finished processes
+    WakeupStats wakeups;  // real-time mode only
+};
 
 // Statistics structure for reporting to GUI
 struct SchedulerStats {
@@ -15,61 +68,421 @@ struct SchedulerStats {
     int readyProcesses = 0;
     int waitingProcesses = 0;
     int terminatedProcesses = 0;
-    double cpuUtilization = 0.0; // percentage
+    double cpuUtilization = 0.0; // busy share of all CPUs over the elapsed clock, percentage
     int contextSwitchCount = 0;
     double averageWaitTime = 0.0;
     double averageTurnaroundTime = 0.0;
+    long long simulatedTimeMs = 0;   // scheduler clock (virtual or wall)
+    long long eventsProcessed = 0;   // discrete-event mode only
+    int cpuCount = 1;
+    int migrationCount = 0;
+    int loadImbalance = 0;           // busiest minus idlest CPU, in runnable processes
+    std::vector<CpuStats> cpus;
+    DeadlineStats deadlines;
+    // Never null from the scheduler. A LIVE sink rebuilds it together with the process
+    // snapshot, at most every SNAPSHOT_INTERVAL_MS (a reader of a stopped scheduler gets
+    // it current); the averages above include live processes and are always current.
+    std::shared_ptr<const StatsHistograms> histograms;
+    LockStats schedulerLock; // contention on the scheduler's lock
+    uint64_t generation = 0; // bumped by every publication; 0 from a non-LIVE sink
+};
+
+// Process list published by the scheduler; readers see it through a pinned,
+// read-only SnapshotBuffer view, never a copy
+struct ProcessSnapshot {
+    std::vector<Process> processes; // arrived processes plus retired ones (see setRetiredHistoryLimit()), by PID
+    long long timeMs = 0;           // scheduler clock when taken
+    uint64_t epoch = 0;             // bumped by every publication
+};
+
+using ProcessSnapshotView = SnapshotBuffer<ProcessSnapshot>::View;
+
+// How the scheduler loop advances time
+enum class ClockMode {
+    REAL_TIME, // sleep for every quantum (interactive GUI)
+    VIRTUAL    // discrete-event simulation, runs as fast as events can be processed
 };
 
-class Scheduler {
+// Scheduler clocks, in ms. SwitchableClock follows a ClockMode chosen at run
+// time; VirtualClock is always virtual, so mode checks fold away at compile time.
+class SwitchableClock {
+public:
+    ClockMode mode() const { return mode_; }
+    bool setMode(ClockMode mode) { // continues from the current time in either direction
+        long long current = now();
+        if (mode == ClockMode::REAL_TIME) {
+            originMs_ = current;
+            origin_ = std::chrono::steady_clock::now();
+        } else {
+            virtualMs_ = current;
+        }
+        mode_ = mode;
+        return true;
+    }
+    long long now() const {
+        if (mode_ == ClockMode::VIRTUAL) return virtualMs_;
+        auto elapsed = std::chrono::steady_clock::now() - origin_;
+        return originMs_ + std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+    }
+    void advanceTo(long long ms) { virtualMs_ = ms; } // virtual mode only
+    // REAL_TIME mode: the steady_clock instant at which now() reaches ms
+    std::chrono::steady_clock::time_point wallTime(long long ms) const {
+        return origin_ + std::chrono::milliseconds(ms - originMs_);
+    }
+
+private:
+    ClockMode mode_ = ClockMode::REAL_TIME;
+    // REAL_TIME: now() is originMs_ at origin_ and follows the wall clock from there
+    std::chrono::steady_clock::time_point origin_ = std::chrono::steady_clock::now();
+    long long originMs_ = 0;
+    std::atomic<long long> virtualMs_{0};
+};
+
+class VirtualClock {
+public:
+    static constexpr ClockMode mode() { return ClockMode::VIRTUAL; }
+    bool setMode(ClockMode mode) { return mode == ClockMode::VIRTUAL; }
+    long long now() const { return virtualMs_; }
+    void advanceTo(long long ms) { virtualMs_ = ms; }
+    // Virtual time only moves with the events, so no wall-clock deadline is ever
+    // derived from it; this keeps the real-time code paths compiling
+    std::chrono::steady_clock::time_point wallTime(long long ms) const {
+        return std::chrono::steady_clock::now() + std::chrono::milliseconds(ms - now());
+    }
+
+private:
+    std::atomic<long long> virtualMs_{0};
+};
+
+// Stats sinks. CallbackStatsSink recomputes SchedulerStats after every change
+// and passes them to a std::function (the GUI). NullStatsSink suits batch
+// runs: nothing is computed until getStats() is called.
+class CallbackStatsSink {
+public:
+    static constexpr bool LIVE = true;
+    using Callback = std::function<void(const SchedulerStats&)>;
+
+    void setCallback(Callback cb) { callback_ = std::move(cb); }
+    void operator()(const SchedulerStats& stats) const {
+        if (callback_) callback_(stats);
+    }
+
+private:
+    Callback callback_;
+};
+
+struct NullStatsSink {
+    static constexpr bool LIVE = false;
+    void operator()(const SchedulerStats&) const {}
+};
+
+// What the CPUs run
+enum class ExecutionMode {
+    SIMULATED, // one scheduler thread models every CPU
+    TASKS      // one worker thread per CPU runs submitted callables on the wall clock
+};
+
+// Timed wake-ups (I/O completion, waitProcess) live in the timer wheel instead
+enum class SchedulerEventType {
+    ARRIVAL,
+    QUANTUM_EXPIRY
+};
+
+// Control request queued by the *Async methods
+enum class SchedulerCommandType {
+    CREATE,
+    CREATE_REAL_TIME,
+    TERMINATE,
+    BLOCK,
+    UNBLOCK
+};
+
+struct SchedulerCommand {
+    SchedulerCommandType type = SchedulerCommandType::CREATE;
+    int pid = 0;             // TERMINATE, BLOCK, UNBLOCK
+    std::string name;        // CREATE*
+    int priority = 0;
+    int burstTime = 0;
+    RealTimeParams realTime; // CREATE_REAL_TIME
+    std::optional<std::promise<int>> result; // CREATE*: receives the PID, or -1
+};
+
+// Entry in the discrete-event queue
+struct SchedulerEvent {
+    long long time = 0;   // virtual ms at which the event fires
+    uint64_t seq = 0;     // insertion order, breaks ties between equal times
+    SchedulerEventType type = SchedulerEventType::ARRIVAL;
+    ProcessHandle process = INVALID_PROCESS;
+    int pid = 0;          // detects events whose table row has since been recycled
+    int cpu = 0;          // QUANTUM_EXPIRY: CPU whose slice ends
+};
+
+// Earliest event first; equal times fire in insertion order
+struct SchedulerEventComparator {
+    bool operator()(const SchedulerEvent& a, const SchedulerEvent& b) const {
+        if (a.time != b.time) return a.time > b.time;
+        return a.seq > b.seq;
+    }
+};
+
+// The scheduler core, composed at compile time from
+//   Policy:    each CPU's run queue and decisions. Either DynamicPolicy (picked at run
+//              time, virtual calls) or a concrete class from policies.h (inlined).
+//   Clock:     SwitchableClock or VirtualClock.
+//   StatsSink: CallbackStatsSink or NullStatsSink.
+// Definitions live in scheduler.cpp, which instantiates the combinations
+// named at the end of this file.
+template <typename Policy, typename Clock, typename StatsSink>
+class BasicScheduler {
 public:
     using StatsCallback = std::function<void(const SchedulerStats&)>;
 
-    Scheduler();
-    ~Scheduler();
+    explicit BasicScheduler(ReadyQueueType queueType = ReadyQueueType::BINARY_HEAP,
+                            int priorityLevels = DEFAULT_PRIORITY_LEVELS,
+                            int cpuCount = 1);
+    BasicScheduler(const PolicyOptions& options, int cpuCount);
+    ~BasicScheduler();
 
     // Configuration
     void setTimeQuantum(int ms);
-    void setAgingFactor(int seconds);
+    void setAgingFactor(int seconds);  // also the MLFQ boost interval
+    // Policy options of a DynamicPolicy apply from the next setPolicy(); a
+    // concrete policy reads them only from the constructor's PolicyOptions
+    void setMlfqLevels(int levels);
+    void setRandomSeed(uint64_t seed); // lottery draws
+    void setClockMode(ClockMode mode); // only takes effect while stopped, and if Clock supports it
+    ClockMode getClockMode() const;
+    int getCpuCount() const;
+    // Only while stopped; TASKS forces REAL_TIME. Leaving TASKS is refused while
+    // submitted tasks have not finished.
+    void setExecutionMode(ExecutionMode mode);
+    ExecutionMode getExecutionMode() const;
+    // DynamicPolicy only: queued processes move to the new policy's queues
+    void setPolicy(SchedulingPolicyType type);
+    SchedulingPolicyType getPolicy() const;
+    // Terminated processes kept in the process list; the oldest drop out beyond it.
+    // Unlimited by default. Counts and averages always cover every process.
+    void setRetiredHistoryLimit(size_t count);
 
     // Process management
-    std::shared_ptr<Process> createProcess(const std::string& name, int priority, int burstTime);
+    int createProcess(const std::string& name, int priority, int burstTime); // returns the PID
+    // Real-time process, subject to the admission test: the densities
+    // wcet / min(period, deadline) of all admitted processes must fit on the
+    // CPUs. Returns the PID, or -1 if the parameters are invalid or it does not fit.
+    int createProcess(const std::string& name, int priority, const RealTimeParams& rt);
     void terminateProcess(int pid);
     void blockProcess(int pid);
     void unblockProcess(int pid);
+    void waitProcess(int pid, int ms); // sleep a RUNNING or READY process (kernel module WAIT)
+
+    // Asynchronous variants: the command goes onto a lock-free queue without
+    // touching the scheduler lock and is applied at the start of the next tick
+    // (or by the next synchronous call, so one thread's calls stay in order).
+    // The futures yield the PID, or -1 where createProcess() would return it.
+    std::future<int> createProcessAsync(const std::string& name, int priority, int burstTime);
+    std::future<int> createProcessAsync(const std::string& name, int priority, const RealTimeParams& rt);
+    void terminateProcessAsync(int pid);
+    void blockProcessAsync(int pid);
+    void unblockProcessAsync(int pid);
+
+    // Admit a process at a future point of the scheduler clock
+    int scheduleArrival(const std::string& name, int priority, int burstTime, long long arrivalMs);
+    int scheduleArrival(const std::string& name, int priority, const RealTimeParams& rt, long long arrivalMs);
 
-    // Control
+    // TASKS mode: run a callable under the same priority/aging policy; returns the PID,
+    // or -1 in SIMULATED mode or for an empty task, which would never run.
+    // In this mode processes from createProcess() occupy a worker for their simulated slices.
+    int submitTask(const std::string& name, int priority, Task task);
+
+    // Control. start() on a running scheduler resumes it. stop() joins the
+    // scheduler thread (or the workers), so no loop outlives it.
     void start();
     void pause();
+    void resume();
     void stop();
 
-    // Callback registration
+    // Discrete-event mode: process events on the calling thread until nothing is left
+    void runToCompletion();
+    long long getCurrentTime() const; // ms on the scheduler clock
+
+    // Callback registration; CallbackStatsSink only
     void setStatsCallback(StatsCallback cb);
 
     // GUI access methods
-    std::vector<std::shared_ptr<Process>> getProcessList() const;
+    // Lock-free with a LIVE sink: the scheduler republishes after changes, at most every
+    // SNAPSHOT_INTERVAL_MS. While stopped or paused, a call after changes rebuilds it
+    // under the lock. Otherwise built on demand under the lock.
+    // Holding the view for long only delays publication; it never blocks the scheduler.
+    ProcessSnapshotView getProcessSnapshot() const;
+    std::vector<Process> getProcessList() const; // copy of getProcessSnapshot()->processes
+    // Without the lock with a LIVE sink: a consistent copy of the latest published stats.
+    // While stopped or paused, a call after changes first republishes the histograms
+    // under the lock. Otherwise computed on demand under the lock.
     SchedulerStats getStats() const;
+    // Generation of the latest published stats, one atomic load (plus getStats()'s
+    // catch-up while stopped); pollers compare it with SchedulerStats::generation to
+    // skip work when nothing changed
+    uint64_t getStatsGeneration() const;
 
 private:
     void schedulerLoop(); // runs in background thread
-    void selectNextProcess();
-    void contextSwitch(std::shared_ptr<Process> next);
+    void workerLoop(int cpu); // TASKS mode, one thread per CPU
+    void signalWork();
+    // Loops block on workCv_ rather than polling: read workSeen() before looking for
+    // work, then waitUntil() returns on a later signalWork(), on stop(), or at the
+    // absolute deadline (scheduler clock ms; NO_WAKEUP: none). Returns how late a
+    // deadline wake-up was in microseconds, -1 if signalled.
+    static constexpr long long NO_WAKEUP = -1;
+    uint64_t workSeen();
+    long long waitUntil(uint64_t seen, long long deadlineMs);
+    void realTimeLoop();
+    void eventLoop();
+    bool processNextEvent();
+
+    // One simulated CPU: a private run queue (owned by its policy) and the process it is running
+    struct Cpu {
+        Cpu(ProcessTable& table, const PolicyOptions& options) : policy(table, options) {}
+
+        Policy policy;
+        ProcessHandle current = INVALID_PROCESS;
+        // The slice in progress; discrete-event mode also queues a QUANTUM_EXPIRY event for it
+        bool sliceInFlight = false;
+        long long sliceStart = 0; // execution before this is already accounted
+        long long sliceEnd = 0;
+        uint64_t sliceEvent = 0;
+        long long busyTimeUs = 0;
+        int contextSwitches = 0;
+        int migrations = 0;
+    };
+
+    void submitCommand(SchedulerCommand command);
+
+    // The helpers below touch table_ and expect the caller to hold lock_
+    void drainCommands(); // applies queued commands in submission order
+    int applyCommand(SchedulerCommand& command); // returns the PID for CREATE*
+    int spawnProcess(const std::string& name, int priority, int burstTime);
+    int spawnRealTimeProcess(const std::string& name, int priority, const RealTimeParams& rt);
+    void killProcess(int pid);
+    void blockRunning(int pid);
+    void wakeBlocked(int pid);
+    ProcessHandle newProcess(const std::string& name, int priority, int burstTime, long long arrivalMs);
+    ProcessHandle newRealTimeProcess(const std::string& name, int priority, const RealTimeParams& rt,
+                                     long long arrivalMs); // INVALID_PROCESS if not admitted
+    bool completeJob(ProcessHandle proc, long long now); // false once the last job is done
+    void dispatchSlice(int cpu, long long start);
+    void settleSlices(); // ends in-flight slices now, before the clock changes
+    void runSlice(int cpu, int ms);
+    int sliceLength(int cpu) const; // policy's slice for the CPU's current process
+    void preemptOnArrival(int cpu, ProcessHandle arrived);
+    void requeueCurrent(int cpu, long long now);
+    // A RUNNING process about to wait leaves its CPU now, charged for the part of the
+    // slice it ran. False if that finished it. A task keeps its worker until it returns.
+    bool vacateCpu(ProcessHandle proc, long long now);
+    void admitProcess(ProcessHandle proc);
+    void admitDueArrivals();
+    void makeReady(ProcessHandle proc, long long now); // enqueue on the owning CPU
+    void unqueue(ProcessHandle proc);
+    void pushEvent(long long time, SchedulerEventType type, ProcessHandle proc, int cpu = 0);
+    bool isStale(const SchedulerEvent& ev) const;
+    bool isCurrent(ProcessHandle proc) const;
+    int leastLoadedCpu() const;
+    ProcessHandle steal(int thief);
+    void endSlice(int cpu);
+    void blockForIo(ProcessHandle proc, int ioTime);
+    void sleepUntil(ProcessHandle proc, long long wakeTime);
+    void cancelWakeup(int pid);
+    int wakeExpiredTimers(long long now); // returns processes woken
+    long long nextWakeup() const; // next slice end, timer or arrival; NO_WAKEUP if none
+    void finishTaskSlice(int cpu, TaskStatus status, Task task);
+    void retireProcess(ProcessHandle proc);
+    void selectNextProcess(int cpu);
+    void contextSwitch(int cpu, ProcessHandle next);
     void updateStats();
-    void applyAging();
+    SchedulerStats collectStats() const;
+    bool publishSnapshot(); // false while readers pin the spare buffer
+    void publishStats(SchedulerStats stats);
+    void refreshHistograms();
+    void flushStats();      // publishes the histograms and stats the rate limit held back
+    void flushSnapshot();   // flushStats() plus the process list
+    void catchUp(bool snapshot); // a reader's flushSnapshot() (or flushStats()) while no loop runs
 
     // Internal data
-    ReadyQueue readyQueue_;
-    std::vector<std::shared_ptr<Process>> allProcesses_;
-    std::shared_ptr<Process> currentProcess_ = nullptr;
-    Spinlock lock_;
+    ProcessTable table_; // live processes, column-oriented; rows recycled on retirement
+    std::vector<std::unique_ptr<Cpu>> cpus_;
+    int queued_ = 0; // processes in all run queues together
+    PidMap<ProcessHandle> processIndex_; // live (not yet terminated) processes by PID
+    AdaptiveLock lock_;
+    MpscQueue<SchedulerCommand> commands_; // consumed under lock_, so by one thread at a time
+    std::atomic<int> pendingCommands_{0};  // lets a tick skip the queue when nothing was submitted
     std::atomic<bool> running_{false};
     std::atomic<bool> paused_{false};
     int timeQuantumMs_ = 100; // default 100ms
     int agingFactorSec_ = 5;   // default 5 seconds
-    SchedulerStats stats_;
-    StatsCallback statsCallback_ = nullptr;
+    int nextPid_ = 1;
+    StatsSink statsSink_;
+    // LIVE sinks only: stats for lock-free readers
+    SnapshotBuffer<SchedulerStats> stats_;
+    std::atomic<uint64_t> statsGeneration_{0};
+    bool statsDirty_ = false; // the last publication was declined
+    std::shared_ptr<const StatsHistograms> histograms_; // as of the last refreshHistograms()
+    std::atomic<bool> histogramsDirty_{false}; // written under lock_; readers use it as a hint
+
+    // Process list for readers (GUI); rate-limited on the wall clock
+    static constexpr long long SNAPSHOT_INTERVAL_MS = 10;
+    SnapshotBuffer<ProcessSnapshot> snapshot_;
+    uint64_t snapshotEpoch_ = 0;
+    std::atomic<bool> snapshotDirty_{false}; // written under lock_; readers use it as a hint
+    std::chrono::steady_clock::time_point lastSnapshot_;
     
-    // I/O simulation
-    std::vector<std::pair<std::shared_ptr<Process>, int>> blockedProcesses_; // process, remaining I/O time
+    // I/O simulation: blocked processes keyed by wake-up time
+    using WakeupTimers = TimerWheel<ProcessHandle>;
+    WakeupTimers wakeupTimers_;
+    PidMap<WakeupTimers::TimerId> wakeupTimerIds_; // pid -> pending wake-up
     int ioSimulationCounter_ = 0;
+
+    // Real-time admission and deadline accounting
+    long long realTimeDensityPpm_ = 0; // sum over admitted live processes
+    DeadlineStats deadlineStats_;
+    long long totalLatenessMs_ = 0;
+    WakeupStats wakeupStats_;
+
+    // Policy, used to build each CPU's run queue
+    PolicyOptions policyOptions(int cpu) const;
+    void configurePolicy(int cpu);
+    PolicyOptions policyOptions_;
+
+    // Task execution
+    ExecutionMode executionMode_ = ExecutionMode::SIMULATED;
+    std::vector<Task> tasks_; // by handle; empty for simulated processes
+    std::thread schedulerThread_; // SIMULATED mode
+    std::vector<std::thread> workers_;
+    std::mutex workMutex_;    // only for parking idle loops
+    std::condition_variable workCv_;
+    uint64_t workSignal_ = 0; // bumped under workMutex_ whenever work may be available
+
+    Clock clock_;
+
+    // Discrete-event simulation (arrivals are also honoured in real-time mode)
+    std::priority_queue<SchedulerEvent, std::vector<SchedulerEvent>, SchedulerEventComparator> events_;
+    uint64_t nextEventSeq_ = 0;
+    long long eventsProcessed_ = 0;
 };
+
+// The runtime-configurable scheduler used by the GUI and embedders
+using Scheduler = BasicScheduler<DynamicPolicy, SwitchableClock, CallbackStatsSink>;
+
+// Discrete-event batch runs with one fixed policy: every policy call is direct
+template <typename Policy>
+using BatchScheduler = BasicScheduler<Policy, VirtualClock, NullStatsSink>;
+
+extern template class BasicScheduler<DynamicPolicy, SwitchableClock, CallbackStatsSink>;
+extern template class BasicScheduler<PriorityPolicy, VirtualClock, NullStatsSink>;
+extern template class BasicScheduler<FcfsPolicy, VirtualClock, NullStatsSink>;
+extern template class BasicScheduler<SjfPolicy, VirtualClock, NullStatsSink>;
+extern template class BasicScheduler<SrtfPolicy, VirtualClock, NullStatsSink>;
+extern template class BasicScheduler<RoundRobinPolicy, VirtualClock, NullStatsSink>;
+extern template class BasicScheduler<CfsPolicy, VirtualClock, NullStatsSink>;
+extern template class BasicScheduler<MlfqPolicy, VirtualClock, NullStatsSink>;
+extern template class BasicScheduler<EdfPolicy, VirtualClock, NullStatsSink>;
+extern template class BasicScheduler<StridePolicy, VirtualClock, NullStatsSink>;
+extern template class BasicScheduler<LotteryPolicy, VirtualClock, NullStatsSink>;
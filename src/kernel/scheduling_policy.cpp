@@ -0,0 +1,59 @@
+#include "scheduling_policy.h"
+#include "policies.h"
+
+std::unique_ptr<SchedulingPolicy> makeSchedulingPolicy(SchedulingPolicyType type,
+                                                       ProcessTable& table,
+                                                       const PolicyOptions& options) {
+    switch (type) {
+        case SchedulingPolicyType::FCFS:        return std::make_unique<FcfsPolicy>(table, options);
+        case SchedulingPolicyType::SJF:         return std::make_unique<SjfPolicy>(table, options);
+        case SchedulingPolicyType::SRTF:        return std::make_unique<SrtfPolicy>(table, options);
+        case SchedulingPolicyType::ROUND_ROBIN: return std::make_unique<RoundRobinPolicy>(table, options);
+        case SchedulingPolicyType::CFS:         return std::make_unique<CfsPolicy>(table, options);
+        case SchedulingPolicyType::MLFQ:        return std::make_unique<MlfqPolicy>(table, options);
+        case SchedulingPolicyType::EDF:         return std::make_unique<EdfPolicy>(table, options);
+        case SchedulingPolicyType::STRIDE:      return std::make_unique<StridePolicy>(table, options);
+        case SchedulingPolicyType::LOTTERY:     return std::make_unique<LotteryPolicy>(table, options);
+        case SchedulingPolicyType::PRIORITY:    break;
+    }
+    return std::make_unique<PriorityPolicy>(table, options);
+}
+
+namespace {
+
+struct PolicyName {
+    SchedulingPolicyType type;
+    const char* name;
+};
+
+const PolicyName POLICY_NAMES[] = {
+    {SchedulingPolicyType::PRIORITY, "priority"},
+    {SchedulingPolicyType::FCFS, "fcfs"},
+    {SchedulingPolicyType::SJF, "sjf"},
+    {SchedulingPolicyType::SRTF, "srtf"},
+    {SchedulingPolicyType::ROUND_ROBIN, "rr"},
+    {SchedulingPolicyType::CFS, "cfs"},
+    {SchedulingPolicyType::MLFQ, "mlfq"},
+    {SchedulingPolicyType::EDF, "edf"},
+    {SchedulingPolicyType::STRIDE, "stride"},
+    {SchedulingPolicyType::LOTTERY, "lottery"},
+};
+
+} // namespace
+
+const char* policyName(SchedulingPolicyType type) {
+    for (const auto& entry : POLICY_NAMES) {
+        if (entry.type == type) return entry.name;
+    }
+    return "priority";
+}
+
+bool parsePolicyName(const std::string& name, SchedulingPolicyType& type) {
+    for (const auto& entry : POLICY_NAMES) {
+        if (name == entry.name) {
+            type = entry.type;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "process_table.h"
+#include "ready_queue.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Scheduling disciplines the Scheduler can run
+enum class SchedulingPolicyType {
+    PRIORITY,    // aged priority, non-preemptive (the original behaviour)
+    FCFS,        // first come, first served
+    SJF,         // shortest job first, non-preemptive
+    SRTF,        // shortest remaining time first, preemptive
+    ROUND_ROBIN, // FIFO, preempted at every quantum expiry
+    CFS,         // completely fair: weighted virtual runtime, slice from a target latency
+    MLFQ,        // multi-level feedback queue with periodic boost
+    EDF,         // earliest deadline first over real-time jobs, preemptive
+    STRIDE,      // proportional share, deterministic: lowest pass value runs next
+    LOTTERY      // proportional share, randomized: a ticket is drawn every quantum
+};
+
+// Construction parameters; each policy reads only its own
+struct PolicyOptions {
+    ReadyQueueType queueType = ReadyQueueType::BINARY_HEAP; // PRIORITY
+    int priorityLevels = DEFAULT_PRIORITY_LEVELS;           // PRIORITY
+    int mlfqLevels = 4;                                     // MLFQ
+    uint64_t seed = 1;                                      // LOTTERY draws
+};
+
+// A policy owns one CPU's run queue and makes the pick-next and preemption
+// decisions for it. The Scheduler holds one instance per CPU and calls it
+// under its lock, so implementations are not synchronized. Every process
+// handed to enqueue() is READY with its ready timestamp set. Policies may
+// keep per-process state in the table's vruntime column.
+class SchedulingPolicy {
+public:
+    virtual ~SchedulingPolicy() = default;
+
+    virtual SchedulingPolicyType type() const = 0;
+
+    // Run queue
+    virtual void enqueue(ProcessHandle proc) = 0;
+    virtual ProcessHandle dequeue() = 0;         // next to run, INVALID_PROCESS when empty
+    virtual bool remove(ProcessHandle proc) = 0; // false if not queued
+    virtual size_t size() const = 0;
+    bool empty() const { return size() == 0; }
+
+    // Length of the slice proc is about to start, and the time it actually ran
+    virtual int timeSlice(ProcessHandle proc, int quantumMs) const { (void)proc; return quantumMs; }
+    virtual void charge(ProcessHandle proc, int ranMs) { (void)proc; (void)ranMs; }
+
+    // Preemption: at the end of a full slice, and when proc becomes READY on
+    // this CPU while current is mid-slice (discrete-event mode only)
+    virtual bool preemptAtSliceEnd(ProcessHandle current) const { (void)current; return false; }
+    virtual bool preemptOnArrival(ProcessHandle current, ProcessHandle proc) const {
+        (void)current; (void)proc;
+        return false;
+    }
+
+    // Scheduler configuration, and the scheduler clock before each decision
+    virtual void setAgingFactor(int seconds) { (void)seconds; }
+    virtual void setTimeQuantum(int ms) { (void)ms; }
+    virtual void tick(long long now) { (void)now; }
+};
+
+std::unique_ptr<SchedulingPolicy> makeSchedulingPolicy(SchedulingPolicyType type,
+                                                       ProcessTable& table,
+                                                       const PolicyOptions& options = PolicyOptions());
+
+// A policy chosen at run time, holding any SchedulingPolicy and forwarding
+// through its vtable. It is the default policy of Scheduler, where
+// setPolicy() swaps it. A BasicScheduler with a concrete policy class
+// instead (see policies.h) avoids the indirection.
+class DynamicPolicy {
+public:
+    DynamicPolicy(ProcessTable& table, const PolicyOptions& options,
+                  SchedulingPolicyType type = SchedulingPolicyType::PRIORITY)
+        : impl_(makeSchedulingPolicy(type, table, options)) {}
+
+    // Installs policy and returns the previous one, with its queue intact
+    std::unique_ptr<SchedulingPolicy> replace(std::unique_ptr<SchedulingPolicy> policy) {
+        impl_.swap(policy);
+        return policy;
+    }
+
+    SchedulingPolicyType type() const { return impl_->type(); }
+    void enqueue(ProcessHandle proc) { impl_->enqueue(proc); }
+    ProcessHandle dequeue() { return impl_->dequeue(); }
+    bool remove(ProcessHandle proc) { return impl_->remove(proc); }
+    size_t size() const { return impl_->size(); }
+    bool empty() const { return impl_->empty(); }
+    int timeSlice(ProcessHandle proc, int quantumMs) const { return impl_->timeSlice(proc, quantumMs); }
+    void charge(ProcessHandle proc, int ranMs) { impl_->charge(proc, ranMs); }
+    bool preemptAtSliceEnd(ProcessHandle current) const { return impl_->preemptAtSliceEnd(current); }
+    bool preemptOnArrival(ProcessHandle current, ProcessHandle proc) const {
+        return impl_->preemptOnArrival(current, proc);
+    }
+    void setAgingFactor(int seconds) { impl_->setAgingFactor(seconds); }
+    void setTimeQuantum(int ms) { impl_->setTimeQuantum(ms); }
+    void tick(long long now) { impl_->tick(now); }
+
+private:
+    std::unique_ptr<SchedulingPolicy> impl_;
+};
+
+// "priority", "fcfs", "sjf", "srtf", "rr", "cfs", "mlfq", "edf", "stride", "lottery"
+const char* policyName(SchedulingPolicyType type);
+bool parsePolicyName(const std::string& name, SchedulingPolicyType& type);
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+// Double-buffered publication of an immutable value from one writer to any
+// number of readers. A reader pins the current buffer and reads it in place;
+// the writer fills the other buffer and flips. A buffer is only rewritten
+// once no reader has it pinned, so the writer never waits: while the spare is
+// pinned, publish() declines and the caller retries later. Readers only retry
+// when a flip races with their pin.
+template <typename T>
+class SnapshotBuffer {
+    struct Slot {
+        std::atomic<int> readers{0};
+        T value{};
+    };
+
+public:
+    // A pinned buffer; the value stays unchanged until the View is destroyed
+    class View {
+    public:
+        View() = default;
+        View(View&& other) noexcept : slot_(std::exchange(other.slot_, nullptr)) {}
+        View& operator=(View&& other) noexcept {
+            if (this != &other) {
+                release();
+                slot_ = std::exchange(other.slot_, nullptr);
+            }
+            return *this;
+        }
+        ~View() { release(); }
+
+        const T& operator*() const { return slot_->value; }
+        const T* operator->() const { return &slot_->value; }
+
+    private:
+        friend class SnapshotBuffer;
+        explicit View(Slot* slot) : slot_(slot) {}
+        void release() {
+            if (slot_) slot_->readers.fetch_sub(1, std::memory_order_release);
+        }
+
+        Slot* slot_ = nullptr;
+    };
+
+    SnapshotBuffer() = default;
+    SnapshotBuffer(const SnapshotBuffer&) = delete;
+    SnapshotBuffer& operator=(const SnapshotBuffer&) = delete;
+
+    View read() const {
+        for (;;) {
+            int i = current_.load();
+            slots_[i].readers.fetch_add(1);
+            if (current_.load() == i) return View(&slots_[i]); // not flipped before the pin
+            slots_[i].readers.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Writer only. fill(T&) rewrites the spare buffer in place, so it can reuse
+    // the storage of the value published two flips ago. Returns false, without
+    // calling fill, while a reader still pins the spare.
+    template <typename Fill>
+    bool publish(Fill&& fill) {
+        int spare = 1 - current_.load(std::memory_order_relaxed);
+        if (slots_[spare].readers.load() != 0) return false;
+        fill(slots_[spare].value);
+        current_.store(spare);
+        return true;
+    }
+
+private:
+    mutable Slot slots_[2];
+    std::atomic<int> current_{0};
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+
+// What a task reports when it hands its worker back
+enum class TaskStatus {
+    YIELD, // more work left; requeue with a fresh ready timestamp
+    DONE
+};
+
+// Passed to a task for one time slice. Long-running tasks poll shouldYield()
+// at convenient points and return TaskStatus::YIELD once it is true; nothing
+// preempts a task that does not.
+class TaskContext {
+public:
+    TaskContext(int pid, std::chrono::steady_clock::time_point sliceEnd)
+        : pid_(pid), sliceEnd_(sliceEnd) {}
+
+    int pid() const { return pid_; }
+    bool shouldYield() const { return std::chrono::steady_clock::now() >= sliceEnd_; }
+    std::chrono::steady_clock::time_point sliceEnd() const { return sliceEnd_; }
+
+private:
+    int pid_;
+    std::chrono::steady_clock::time_point sliceEnd_;
+};
+
+// Invoked once per time slice until it returns TaskStatus::DONE
+using Task = std::function<TaskStatus(TaskContext&)>;
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Hierarchical timer wheel with 1 ms ticks: 4 levels of 64 slots cover
+// 64^4 ms (~4.6 hours); later timers are parked in the last level and
+// re-filed when it cascades. Timers live in a recycled node pool linked into
+// per-slot lists, so scheduling and cancelling are O(1) and allocation-free
+// once warm. advance() only visits slots that hold timers or must cascade.
+// Not synchronized.
+template <typename T>
+class TimerWheel {
+public:
+    using TimerId = uint32_t;
+    static constexpr TimerId INVALID_TIMER = UINT32_MAX;
+
+    explicit TimerWheel(long long now = 0) : current_(now) {
+        for (auto& level : head_) for (auto& h : level) h = NIL;
+        for (auto& level : tail_) for (auto& t : level) t = NIL;
+    }
+
+    // Timers due at or before the current tick fire on the next advance()
+    TimerId schedule(long long expires, const T& value) {
+        TimerId id;
+        if (freeHead_ != NIL) {
+            id = freeHead_;
+            freeHead_ = nodes_[id].next;
+        } else {
+            id = static_cast<TimerId>(nodes_.size());
+            nodes_.emplace_back();
+        }
+        Node& node = nodes_[id];
+        node.value = value;
+        node.expires = expires > current_ ? expires : current_ + 1;
+        node.active = true;
+        link(id);
+        ++size_;
+        return id;
+    }
+
+    bool cancel(TimerId id) {
+        if (id >= nodes_.size() || !nodes_[id].active) return false;
+        unlink(id);
+        release(id);
+        return true;
+    }
+
+    // Advances the wheel to 'now', calling onExpire(value, expires) for every
+    // due timer in expiry order. Callbacks may schedule new timers.
+    template <typename F>
+    void advance(long long now, F&& onExpire) {
+        while (current_ < now) {
+            // Jump straight to the next tick that fires a slot or cascades one;
+            // the empty ticks and cascades in between are no-ops
+            long long next = nextExpiryBound();
+            if (next < 0 || next > now) {
+                current_ = now;
+                break;
+            }
+            current_ = next;
+            if ((current_ & (SLOTS - 1)) == 0) cascade();
+            fireSlot(static_cast<int>(current_ & (SLOTS - 1)), onExpire);
+        }
+    }
+
+    // Earliest tick at which advance() can fire or cascade anything; never later
+    // than the earliest pending expiry. -1 when no timers are pending.
+    long long nextExpiryBound() const {
+        long long best = -1;
+        for (int level = 0; level < LEVELS; ++level) {
+            uint64_t bits = occupied_[level];
+            if (!bits) continue;
+            // Slots cover the 64 blocks after the current one, in cyclic order
+            int shift = level * BITS;
+            long long block = current_ >> shift;
+            int pos = static_cast<int>(block & (SLOTS - 1));
+            uint64_t ahead = rotateRight(bits, (pos + 1) % SLOTS);
+            long long tick = (block + __builtin_ctzll(ahead) + 1) << shift;
+            if (best < 0 || tick < best) best = tick;
+        }
+        return best;
+    }
+
+    long long now() const { return current_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr int BITS = 6;
+    static constexpr int SLOTS = 1 << BITS;
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Node {
+        T value{};
+        long long expires = 0;
+        uint32_t prev = NIL;
+        uint32_t next = NIL;
+        uint8_t level = 0;
+        uint8_t slot = 0;
+        bool active = false;
+    };
+
+    static uint64_t rotateRight(uint64_t bits, int n) {
+        return n == 0 ? bits : (bits >> n) | (bits << (SLOTS - n));
+    }
+
+    void link(TimerId id) {
+        Node& node = nodes_[id];
+        long long delta = node.expires - current_;
+        int level = 0;
+        while (level < LEVELS - 1 && delta >= (1LL << ((level + 1) * BITS))) ++level;
+        long long expires = node.expires;
+        long long horizon = current_ + (1LL << (LEVELS * BITS)) - 1;
+        if (expires > horizon) expires = horizon; // re-filed on cascade
+        int slot = static_cast<int>((expires >> (level * BITS)) & (SLOTS - 1));
+
+        node.level = static_cast<uint8_t>(level);
+        node.slot = static_cast<uint8_t>(slot);
+        node.next = NIL;
+        node.prev = tail_[level][slot];
+        if (node.prev != NIL) {
+            nodes_[node.prev].next = id;
+        } else {
+            head_[level][slot] = id;
+        }
+        tail_[level][slot] = id;
+        occupied_[level] |= uint64_t{1} << slot;
+    }
+
+    void unlink(TimerId id) {
+        Node& node = nodes_[id];
+        if (node.prev != NIL) nodes_[node.prev].next = node.next;
+        else head_[node.level][node.slot] = node.next;
+        if (node.next != NIL) nodes_[node.next].prev = node.prev;
+        else tail_[node.level][node.slot] = node.prev;
+        if (head_[node.level][node.slot] == NIL) {
+            occupied_[node.level] &= ~(uint64_t{1} << node.slot);
+        }
+    }
+
+    void release(TimerId id) {
+        Node& node = nodes_[id];
+        node.active = false;
+        node.value = T{};
+        node.next = freeHead_;
+        freeHead_ = id;
+        --size_;
+    }
+
+    uint32_t detachSlot(int level, int slot) {
+        uint32_t first = head_[level][slot];
+        head_[level][slot] = NIL;
+        tail_[level][slot] = NIL;
+        occupied_[level] &= ~(uint64_t{1} << slot);
+        return first;
+    }
+
+    // Called when current_ enters a new level-0 rotation: pull the matching
+    // higher-level slots down, highest level first
+    void cascade() {
+        int top = 1;
+        while (top < LEVELS - 1 && ((current_ >> (top * BITS)) & (SLOTS - 1)) == 0) ++top;
+        for (int level = top; level >= 1; --level) {
+            int slot = static_cast<int>((current_ >> (level * BITS)) & (SLOTS - 1));
+            uint32_t id = detachSlot(level, slot);
+            while (id != NIL) {
+                uint32_t next = nodes_[id].next;
+                link(id);
+                id = next;
+            }
+        }
+    }
+
+    template <typename F>
+    void fireSlot(int slot, F& onExpire) {
+        uint32_t id = detachSlot(0, slot);
+        while (id != NIL) {
+            uint32_t next = nodes_[id].next;
+            T value = nodes_[id].value;
+            long long expires = nodes_[id].expires;
+            release(id);
+            onExpire(value, expires);
+            id = next;
+        }
+    }
+
+    std::vector<Node> nodes_;
+    uint32_t freeHead_ = NIL;
+    uint32_t head_[LEVELS][SLOTS];
+    uint32_t tail_[LEVELS][SLOTS];
+    uint64_t occupied_[LEVELS] = {0, 0, 0, 0};
+    long long current_;
+    size_t size_ = 0;
+};
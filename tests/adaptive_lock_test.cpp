@@ -0,0 +1,67 @@
+// AdaptiveLock: mutual exclusion under contention, parking, counters
+#include "adaptive_lock.h"
+#include "check.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+void excludesConcurrentHolders() {
+    constexpr int THREADS = 4;
+    constexpr int ROUNDS = 200000;
+    AdaptiveLock lock;
+    long long counter = 0; // plain: only the lock protects it
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < ROUNDS; ++i) {
+                LockGuard guard(lock);
+                counter++;
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    LockGuard guard(lock);
+    const LockStats& stats = lock.stats();
+    check(counter == static_cast<long long>(THREADS) * ROUNDS, "adaptive lock: no increment lost");
+    check(stats.acquisitions == static_cast<uint64_t>(THREADS) * ROUNDS + 1, "adaptive lock: every acquisition counted");
+    check(stats.contended <= stats.acquisitions, "adaptive lock: contended is a subset");
+    check(stats.holdSamples == (stats.acquisitions - 1 + AdaptiveLock::HOLD_SAMPLE_INTERVAL - 1) /
+                                   AdaptiveLock::HOLD_SAMPLE_INTERVAL,
+          "adaptive lock: one hold in HOLD_SAMPLE_INTERVAL sampled");
+}
+
+// A waiter behind a long hold stops spinning and parks until the unlock
+void parksBehindLongHold() {
+    AdaptiveLock lock;
+    lock.lock(); // first acquisition, so its hold is sampled
+    bool entered = false;
+    std::thread waiter([&] {
+        LockGuard guard(lock);
+        entered = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    lock.unlock();
+    waiter.join();
+
+    LockGuard guard(lock);
+    const LockStats& stats = lock.stats();
+    check(entered, "adaptive lock: waiter got the lock after the unlock");
+    check(stats.contended == 1, "adaptive lock: the waiter found it held");
+    check(stats.spins > 0, "adaptive lock: the waiter spun first");
+#ifdef __linux__
+    check(stats.parks >= 1, "adaptive lock: then parked on the futex");
+#endif
+    check(stats.maxHoldNs >= 50 * 1000 * 1000ull, "adaptive lock: the long hold was timed");
+}
+
+} // namespace
+
+int main() {
+    excludesConcurrentHolders();
+    parksBehindLongHold();
+    return finish("adaptive_lock_test");
+}
@@ -0,0 +1,108 @@
+// IndexedHeap, FifoRing and the FCFS, SJF, SRTF and round-robin policies
+#include "check.h"
+#include "policies.h"
+#include <vector>
+
+namespace {
+
+struct ByHandle {
+    const std::vector<int>* keys;
+    bool operator()(ProcessHandle a, ProcessHandle b) const { return (*keys)[a] < (*keys)[b]; }
+};
+
+void indexedHeapTracksPositions() {
+    std::vector<int> keys = {50, 10, 40, 20, 30};
+    IndexedHeap<ByHandle> heap(ByHandle{&keys});
+    for (ProcessHandle h = 0; h < keys.size(); ++h) heap.push(h);
+    heap.push(3);
+    check(heap.size() == 5, "heap: a second push is a no-op");
+    check(heap.top() == 1, "heap: smallest key on top");
+
+    check(heap.remove(2), "heap: remove from the middle");
+    check(!heap.remove(2), "heap: remove twice fails");
+    keys[0] = 5;
+    heap.update(0);
+    std::vector<ProcessHandle> order;
+    for (ProcessHandle h = heap.pop(); h != INVALID_PROCESS; h = heap.pop()) order.push_back(h);
+    check(order == std::vector<ProcessHandle>({0, 1, 3, 4}), "heap: pops in key order after update and remove");
+
+    for (ProcessHandle h = 0; h < keys.size(); ++h) heap.push(h);
+    for (int& k : keys) k = -k;
+    heap.rebuild();
+    check(heap.top() == 2, "heap: rebuild after every key changed");
+}
+
+void fifoRingRemovesInPlace() {
+    FifoRing ring;
+    for (ProcessHandle h = 0; h < 20; ++h) ring.push(h); // grows past its first capacity
+    ring.push(4);
+    check(ring.size() == 20, "fifo: a second push is a no-op");
+    check(ring.remove(4) && !ring.remove(4), "fifo: remove once");
+    check(ring.front() == 0, "fifo: front");
+    bool ordered = true;
+    ProcessHandle expected = 0;
+    for (ProcessHandle h = ring.pop(); h != INVALID_PROCESS; h = ring.pop()) {
+        if (expected == 4) expected++;
+        ordered = ordered && h == expected++;
+    }
+    check(ordered && expected == 20, "fifo: arrival order, skipping the removed entry");
+    check(ring.empty(), "fifo: empty after draining");
+    ring.push(4);
+    check(ring.pop() == 4, "fifo: a removed handle can be queued again");
+}
+
+std::vector<ProcessHandle> drain(SchedulingPolicy& policy) {
+    std::vector<ProcessHandle> order;
+    for (ProcessHandle h = policy.dequeue(); h != INVALID_PROCESS; h = policy.dequeue()) order.push_back(h);
+    return order;
+}
+
+void fcfsAndRoundRobin() {
+    ProcessTable table;
+    FcfsPolicy fcfs(table, PolicyOptions());
+    ProcessHandle a = addReady(table, 1, 9, 300, 0);
+    ProcessHandle b = addReady(table, 2, 0, 100, 5);
+    ProcessHandle c = addReady(table, 3, 5, 200, 10);
+    for (ProcessHandle h : {a, b, c}) fcfs.enqueue(h);
+    check(!fcfs.preemptAtSliceEnd(a), "fcfs: never preempts");
+    check(drain(fcfs) == std::vector<ProcessHandle>({a, b, c}), "fcfs: arrival order regardless of priority");
+
+    RoundRobinPolicy rr(table, PolicyOptions());
+    check(!rr.preemptAtSliceEnd(a), "rr: keeps the CPU when nobody waits");
+    rr.enqueue(b);
+    check(rr.preemptAtSliceEnd(a), "rr: yields at quantum expiry when someone waits");
+    check(rr.timeSlice(a, 70) == 70, "rr: slice is the quantum");
+}
+
+void shortestFirst() {
+    ProcessTable table;
+    ProcessHandle longJob = addReady(table, 1, 5, 300, 0);
+    ProcessHandle shortJob = addReady(table, 2, 5, 100, 0);
+    ProcessHandle tie = addReady(table, 3, 5, 100, 0);
+
+    SjfPolicy sjf(table, PolicyOptions());
+    for (ProcessHandle h : {longJob, tie, shortJob}) sjf.enqueue(h);
+    check(drain(sjf) == std::vector<ProcessHandle>({shortJob, tie, longJob}), "sjf: burst order, PID breaks ties");
+
+    // SRTF orders on what is left: run the long job down below the others
+    SrtfPolicy srtf(table, PolicyOptions());
+    table.setState(longJob, ProcessState::RUNNING, 0);
+    table.execute(longJob, 250);
+    srtf.enqueue(shortJob);
+    check(!srtf.preemptAtSliceEnd(longJob), "srtf: 50 ms left is not preempted by 100 ms");
+    check(srtf.preemptOnArrival(shortJob, longJob), "srtf: a newcomer with less left preempts");
+    table.setState(longJob, ProcessState::READY, 250);
+    srtf.enqueue(longJob);
+    check(srtf.dequeue() == longJob, "srtf: least remaining time first");
+    check(srtf.remove(shortJob) && srtf.empty(), "srtf: remove");
+}
+
+} // namespace
+
+int main() {
+    indexedHeapTracksPositions();
+    fifoRingRemovesInPlace();
+    fcfsAndRoundRobin();
+    shortestFirst();
+    return finish("basic_policies_test");
+}
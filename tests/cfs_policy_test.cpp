@@ -0,0 +1,110 @@
+// CfsPolicy: vruntime order, weighted slices, sleeper credit, fair share
+#include "check.h"
+#include "policies.h"
+
+namespace {
+
+void runsSmallestVruntime() {
+    ProcessTable table;
+    CfsPolicy cfs(table, PolicyOptions());
+    ProcessHandle a = addReady(table, 1, 5, 1000, 0);
+    ProcessHandle b = addReady(table, 2, 5, 1000, 0);
+    ProcessHandle c = addReady(table, 3, 5, 1000, 0);
+    table.setVruntime(a, 30000);
+    table.setVruntime(b, 10000);
+    table.setVruntime(c, 10000);
+    cfs.enqueue(a);
+    cfs.enqueue(b);
+    cfs.enqueue(c);
+    cfs.enqueue(b);
+    check(cfs.size() == 3, "cfs: double enqueue ignored");
+
+    check(cfs.dequeue() == b, "cfs: smallest vruntime, lower pid on a tie");
+    check(!cfs.preemptAtSliceEnd(b), "cfs: an equal-vruntime process does not preempt");
+    cfs.charge(b, 10); // nice 0: 1 ms of CPU is 1000 units
+    check(table.vruntime(b) == 20000, "cfs: charge at nice 0 is 1000 per ms");
+    check(cfs.preemptAtSliceEnd(b), "cfs: a smaller queued vruntime preempts at slice end");
+    cfs.enqueue(b);
+
+    check(cfs.remove(c) && !cfs.remove(c), "cfs: remove once");
+    check(cfs.dequeue() == b && cfs.dequeue() == a, "cfs: remaining in vruntime order");
+    check(cfs.dequeue() == INVALID_PROCESS, "cfs: empty");
+}
+
+void weightsScaleSlicesAndVruntime() {
+    ProcessTable table;
+    CfsPolicy cfs(table, PolicyOptions());
+    ProcessHandle heavy = addReady(table, 1, 0, 1000, 0); // weight 9548
+    ProcessHandle light = addReady(table, 2, 5, 1000, 0); // weight 1024
+    cfs.enqueue(heavy);
+    check(cfs.timeSlice(light, 100) == 200 * 1024 / (9548 + 1024), "cfs: light slice is its weight share");
+    cfs.remove(heavy);
+    cfs.enqueue(light);
+    check(cfs.timeSlice(heavy, 100) == 200 * 9548 / (9548 + 1024), "cfs: heavy slice is its weight share");
+    cfs.charge(heavy, 10);
+    check(table.vruntime(heavy) == 10 * 1000LL * 1024 / 9548, "cfs: heavy vruntime grows slower");
+
+    // Past TARGET_LATENCY / MIN_GRANULARITY runnable processes the period stretches
+    ProcessTable crowd;
+    CfsPolicy busy(crowd, PolicyOptions());
+    for (int pid = 1; pid <= 30; ++pid) busy.enqueue(addReady(crowd, pid, 5, 1000, 0));
+    ProcessHandle extra = addReady(crowd, 31, 5, 1000, 0);
+    check(busy.timeSlice(extra, 100) == CfsPolicy::MIN_GRANULARITY_MS, "cfs: slice never below the granularity");
+}
+
+void sleeperCreditIsCapped() {
+    ProcessTable table;
+    CfsPolicy cfs(table, PolicyOptions());
+    ProcessHandle runner = addReady(table, 1, 5, 100000, 0);
+    ProcessHandle sleeper = addReady(table, 2, 5, 100000, 0);
+    cfs.enqueue(runner);
+    for (int i = 0; i < 10; ++i) { // runner alone for 1 s
+        cfs.dequeue();
+        cfs.charge(runner, 100);
+        cfs.enqueue(runner);
+    }
+    cfs.enqueue(sleeper);
+    long long credit = table.vruntime(runner) - table.vruntime(sleeper);
+    check(credit <= CfsPolicy::TARGET_LATENCY_MS * 1000LL / 2, "cfs: waking keeps at most half a period of credit");
+    check(credit > 0, "cfs: but still runs first");
+    check(cfs.preemptOnArrival(runner, sleeper), "cfs: a sleeper far enough behind preempts on wakeup");
+    table.setVruntime(sleeper, table.vruntime(runner) - CfsPolicy::WAKEUP_GRANULARITY);
+    check(!cfs.preemptOnArrival(runner, sleeper), "cfs: within the wakeup granularity no preemption");
+}
+
+// Always-runnable processes share the CPU in proportion to their weights
+void cpuTimeFollowsWeights() {
+    ProcessTable table;
+    CfsPolicy cfs(table, PolicyOptions());
+    ProcessHandle procs[3] = {addReady(table, 1, 3, 1 << 30, 0),  // 2501
+                              addReady(table, 2, 5, 1 << 30, 0),  // 1024
+                              addReady(table, 3, 7, 1 << 30, 0)}; // 423
+    long long ran[3] = {0, 0, 0};
+    for (ProcessHandle h : procs) cfs.enqueue(h);
+    for (int i = 0; i < 3000; ++i) {
+        ProcessHandle h = cfs.dequeue();
+        int slice = cfs.timeSlice(h, 100);
+        cfs.charge(h, slice);
+        ran[h] += slice;
+        cfs.enqueue(h);
+    }
+    double total = static_cast<double>(ran[0] + ran[1] + ran[2]);
+    const int weights[3] = {2501, 1024, 423};
+    bool fair = true;
+    for (int i = 0; i < 3; ++i) {
+        double share = ran[i] / total;
+        double expected = weights[i] / 3948.0;
+        if (share < expected * 0.95 || share > expected * 1.05) fair = false;
+    }
+    check(fair, "cfs: CPU shares within 5% of the weight ratio");
+}
+
+} // namespace
+
+int main() {
+    runsSmallestVruntime();
+    weightsScaleSlicesAndVruntime();
+    sleeperCreditIsCapped();
+    cpuTimeFollowsWeights();
+    return finish("cfs_policy_test");
+}
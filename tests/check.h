@@ -0,0 +1,27 @@
+#pragma once
+
+// Minimal assertion helpers shared by the test executables. A failed check is
+// reported and counted; main() returns finish() so ctest sees the outcome.
+#include "process_table.h"
+#include <cstdio>
+
+inline int checkFailures = 0;
+
+inline void check(bool ok, const char* what) {
+    if (!ok) {
+        std::fprintf(stderr, "FAIL: %s\n", what);
+        checkFailures++;
+    }
+}
+
+inline int finish(const char* suite) {
+    if (checkFailures == 0) std::printf("%s: all checks passed\n", suite);
+    return checkFailures == 0 ? 0 : 1;
+}
+
+// A READY row for policy and queue tests, as the scheduler would enqueue it
+inline ProcessHandle addReady(ProcessTable& table, int pid, int priority, int burstTime, long long readyAt) {
+    ProcessHandle h = table.add(pid, "p" + std::to_string(pid), priority, burstTime, static_cast<int>(readyAt));
+    table.setState(h, ProcessState::READY, readyAt);
+    return h;
+}
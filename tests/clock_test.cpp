@@ -0,0 +1,72 @@
+// SwitchableClock: time continues across mode switches in both directions
+#include "check.h"
+#include "scheduler.h"
+#include <chrono>
+#include <thread>
+
+namespace {
+
+void sleepMs(int ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+void neverGoesBackwards() {
+    SwitchableClock clock;
+    long long last = clock.now();
+    bool monotonic = true;
+    auto observe = [&] {
+        long long now = clock.now();
+        monotonic = monotonic && now >= last;
+        last = now;
+    };
+
+    for (int round = 0; round < 3; ++round) {
+        sleepMs(5);
+        observe();
+        clock.setMode(ClockMode::VIRTUAL);
+        observe();
+        clock.advanceTo(last + 60000); // virtual time runs far ahead of the wall clock
+        observe();
+        clock.setMode(ClockMode::REAL_TIME);
+        observe();
+        check(last >= 60000 * (round + 1), "clock: real time continues from the virtual time");
+        sleepMs(5);
+        observe();
+    }
+    check(monotonic, "clock: now() never decreases across switches");
+
+    long long now = clock.now();
+    auto wall = clock.wallTime(now + 20);
+    auto ahead = std::chrono::duration_cast<std::chrono::milliseconds>(wall - std::chrono::steady_clock::now()).count();
+    check(ahead >= 10 && ahead <= 20, "clock: wallTime() maps onto the shifted origin");
+}
+
+// A virtual run leaves the clock ahead of the wall clock; real time resumes from there
+void schedulerSwitchesAfterVirtualRun() {
+    Scheduler scheduler;
+    scheduler.setClockMode(ClockMode::VIRTUAL);
+    scheduler.createProcess("batch", 5, 3000);
+    scheduler.runToCompletion();
+    long long virtualEnd = scheduler.getCurrentTime();
+    check(virtualEnd >= 3000, "clock: the virtual run advanced the clock");
+
+    scheduler.setClockMode(ClockMode::REAL_TIME);
+    check(scheduler.getCurrentTime() >= virtualEnd, "clock: REAL_TIME after VIRTUAL does not jump back");
+    int pid = scheduler.createProcess("interactive", 5, 20);
+    scheduler.start();
+    sleepMs(200);
+    scheduler.stop();
+    bool finished = false;
+    for (const Process& p : scheduler.getProcessList()) {
+        if (p.getPid() == pid) {
+            finished = p.getState() == ProcessState::TERMINATED && p.turnaroundTime >= 20 && p.turnaroundTime < 1000;
+        }
+    }
+    check(finished, "clock: a process created after the switch has a sane turnaround");
+}
+
+} // namespace
+
+int main() {
+    neverGoesBackwards();
+    schedulerSwitchesAfterVirtualRun();
+    return finish("clock_test");
+}
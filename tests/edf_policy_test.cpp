@@ -0,0 +1,89 @@
+// EdfPolicy and real-time admission: deadline order, preemption, density test
+#include "check.h"
+#include "policies.h"
+#include "scheduler.h"
+
+namespace {
+
+RealTimeParams periodic(int periodMs, int wcetMs, int jobs, int deadlineMs = 0) {
+    RealTimeParams rt;
+    rt.kind = RealTimeKind::PERIODIC;
+    rt.periodMs = periodMs;
+    rt.wcetMs = wcetMs;
+    rt.deadlineMs = deadlineMs;
+    rt.jobs = jobs;
+    return rt;
+}
+
+ProcessHandle addRealTime(ProcessTable& table, int pid, const RealTimeParams& rt, long long releaseMs) {
+    ProcessHandle h = addReady(table, pid, 5, rt.wcetMs, releaseMs);
+    table.setRealTime(h, rt, releaseMs);
+    return h;
+}
+
+void earliestDeadlineFirst() {
+    ProcessTable table;
+    EdfPolicy edf(table, PolicyOptions());
+    ProcessHandle plain = addReady(table, 1, 0, 50, 0);
+    ProcessHandle late = addRealTime(table, 2, periodic(100, 10, 1), 0);      // due at 100
+    ProcessHandle early = addRealTime(table, 3, periodic(100, 10, 1, 30), 0); // due at 30
+    check(table.deadline(plain) == NO_DEADLINE, "edf: an ordinary process has no deadline");
+    edf.enqueue(plain);
+    edf.enqueue(late);
+    edf.enqueue(early);
+
+    check(edf.preemptOnArrival(late, early), "edf: an earlier deadline preempts on arrival");
+    check(!edf.preemptOnArrival(early, late), "edf: a later deadline does not");
+    check(edf.preemptOnArrival(plain, early), "edf: any job preempts an ordinary process");
+    check(edf.dequeue() == early, "edf: earliest deadline first");
+    check(edf.preemptAtSliceEnd(plain), "edf: a queued job takes over from an ordinary process");
+    check(!edf.preemptAtSliceEnd(early), "edf: the earliest job keeps the CPU");
+    check(edf.dequeue() == late, "edf: then the later deadline");
+    check(!edf.preemptAtSliceEnd(plain), "edf: ordinary processes do not preempt each other");
+    check(edf.dequeue() == plain, "edf: ordinary processes run in the gaps");
+}
+
+// The densities wcet / min(period, deadline) must fit on the CPUs
+void admissionControl() {
+    Scheduler scheduler(ReadyQueueType::BINARY_HEAP, DEFAULT_PRIORITY_LEVELS, 1);
+    scheduler.setPolicy(SchedulingPolicyType::EDF);
+    int a = scheduler.createProcess("a", 5, periodic(100, 60, 3));
+    int b = scheduler.createProcess("b", 5, periodic(100, 30, 3, 50)); // density 0.6
+    int c = scheduler.createProcess("c", 5, periodic(100, 40, 3));
+    int bad = scheduler.createProcess("bad", 5, periodic(0, 10, 1));
+    check(a >= 0 && c >= 0, "edf admission: a and c fit");
+    check(b < 0, "edf admission: b's density overflows the CPU");
+    check(bad < 0, "edf admission: invalid parameters refused");
+
+    DeadlineStats deadlines = scheduler.getStats().deadlines;
+    check(deadlines.rejected == 1, "edf admission: one rejection counted");
+    check(deadlines.reservedUtilization == 100.0, "edf admission: a and c reserve the whole CPU");
+
+    scheduler.terminateProcess(a);
+    int retry = scheduler.createProcess("b", 5, periodic(100, 30, 3, 50));
+    check(retry >= 0, "edf admission: terminating frees the reservation");
+}
+
+// A feasible periodic set on one CPU meets every deadline under EDF
+void feasibleSetMeetsDeadlines() {
+    BatchScheduler<EdfPolicy> scheduler(PolicyOptions(), 1);
+    scheduler.setTimeQuantum(5);
+    check(scheduler.createProcess("fast", 5, periodic(10, 4, 30)) >= 0, "edf run: fast admitted");
+    check(scheduler.createProcess("slow", 5, periodic(25, 10, 12)) >= 0, "edf run: slow admitted");
+    scheduler.createProcess("filler", 5, 100);
+    scheduler.runToCompletion();
+
+    DeadlineStats deadlines = scheduler.getStats().deadlines;
+    check(deadlines.jobsCompleted == 42, "edf run: every job completed");
+    check(deadlines.deadlineMisses == 0, "edf run: no deadline missed at 80% utilization");
+    check(deadlines.maxLatenessMs <= 0, "edf run: every job finished by its deadline");
+}
+
+} // namespace
+
+int main() {
+    earliestDeadlineFirst();
+    admissionControl();
+    feasibleSetMeetsDeadlines();
+    return finish("edf_policy_test");
+}
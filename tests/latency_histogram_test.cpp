@@ -0,0 +1,56 @@
+// LatencyHistogram: nearest-rank percentiles, bucket precision, merge
+#include "check.h"
+#include "latency_histogram.h"
+
+namespace {
+
+void nearestRankPercentiles() {
+    LatencyHistogram h;
+    check(h.percentile(50) == 0, "histogram: empty reports 0");
+    for (int v = 1; v <= 11; ++v) h.record(v); // exact buckets below 16
+    check(h.percentile(95) == 11, "histogram: p95 of 11 samples is rank ceil(10.45) = 11");
+    check(h.percentile(50) == 6, "histogram: p50 of 11 samples is rank ceil(5.5) = 6");
+    check(h.percentile(0) == 1, "histogram: p0 is the minimum");
+    check(h.percentile(100) == 11, "histogram: p100 is the maximum");
+    check(h.count() == 11 && h.min() == 1 && h.max() == 11, "histogram: count, min, max");
+    check(h.mean() == 6.0, "histogram: mean");
+
+    LatencyHistogram twenty;
+    for (int v = 1; v <= 20; ++v) twenty.record(v);
+    check(twenty.percentile(95) == 19, "histogram: p95 of 20 samples is rank 19 exactly");
+    check(twenty.percentile(99.9) == 20, "histogram: p99.9 of 20 samples is the maximum");
+}
+
+void bucketPrecision() {
+    LatencyHistogram h;
+    h.record(1000);
+    h.record(1000000);
+    long long low = h.percentile(50);
+    check(low >= 1000 && low <= 1000 + 1000 / LatencyHistogram::SUB_COUNT, "histogram: within one sub-bucket");
+    check(h.percentile(100) == 1000000, "histogram: never above max()");
+    h.record(-5);
+    h.record(LatencyHistogram::MAX_VALUE * 2);
+    check(h.min() == 0 && h.max() == LatencyHistogram::MAX_VALUE, "histogram: values are clamped");
+}
+
+void mergeAddsCounts() {
+    LatencyHistogram a, b;
+    for (int v = 1; v <= 5; ++v) a.record(v);
+    for (int v = 6; v <= 10; ++v) b.record(v);
+    a.merge(b);
+    check(a.count() == 10 && a.min() == 1 && a.max() == 10, "histogram merge: count, min, max");
+    check(a.percentile(50) == 5, "histogram merge: p50 over both");
+
+    LatencyHistogram empty;
+    empty.merge(b);
+    check(empty.min() == 6, "histogram merge: into empty takes the other's min");
+}
+
+} // namespace
+
+int main() {
+    nearestRankPercentiles();
+    bucketPrecision();
+    mergeAddsCounts();
+    return finish("latency_histogram_test");
+}
@@ -0,0 +1,67 @@
+// MlfqPolicy: FIFO levels, demotion on a used-up allotment, periodic boost
+#include "check.h"
+#include "policies.h"
+
+namespace {
+
+void demotesAfterFullAllotment() {
+    ProcessTable table;
+    MlfqPolicy mlfq(table, PolicyOptions());
+    ProcessHandle a = addReady(table, 1, 5, 1000, 0);
+    ProcessHandle b = addReady(table, 2, 5, 1000, 0);
+    ProcessHandle c = addReady(table, 3, 5, 1000, 0);
+    mlfq.enqueue(a);
+    mlfq.enqueue(b);
+    mlfq.enqueue(c);
+    check(mlfq.size() == 3, "mlfq: three queued");
+
+    check(mlfq.dequeue() == a, "mlfq: FIFO within level 0");
+    check(mlfq.timeSlice(a, 100) == 100, "mlfq: level 0 gets one quantum");
+    mlfq.charge(a, 100);
+    check(table.level(a) == 1, "mlfq: full allotment demotes");
+    check(mlfq.timeSlice(a, 100) == 200, "mlfq: level 1 gets two quanta");
+    check(mlfq.preemptAtSliceEnd(a), "mlfq: level-0 work preempts a level-1 process");
+    mlfq.enqueue(a);
+
+    check(mlfq.dequeue() == b, "mlfq: level 0 before level 1");
+    mlfq.charge(b, 40);
+    check(table.level(b) == 0, "mlfq: giving up the CPU early keeps the level");
+    check(mlfq.timeSlice(b, 100) == 60, "mlfq: the rest of the allotment remains");
+    check(mlfq.preemptOnArrival(a, c), "mlfq: level 0 arrival preempts level 1");
+
+    check(mlfq.dequeue() == c, "mlfq: remaining level-0 process");
+    check(mlfq.dequeue() == a, "mlfq: then level 1");
+    check(mlfq.dequeue() == INVALID_PROCESS, "mlfq: empty");
+}
+
+void boostReturnsEveryoneToTop() {
+    ProcessTable table;
+    MlfqPolicy mlfq(table, PolicyOptions());
+    mlfq.setAgingFactor(1); // boost every second
+    ProcessHandle low = addReady(table, 1, 5, 5000, 0);
+    ProcessHandle top = addReady(table, 2, 5, 5000, 0);
+    ProcessHandle away = addReady(table, 3, 5, 5000, 0);
+    for (ProcessHandle h : {low, away}) {
+        mlfq.enqueue(h);
+        mlfq.dequeue();
+        mlfq.charge(h, 100);
+        mlfq.charge(h, 200); // level 2
+    }
+    check(table.level(low) == 2 && table.level(away) == 2, "mlfq boost: demoted twice");
+    mlfq.enqueue(low);
+    mlfq.enqueue(top);
+
+    mlfq.tick(1000);
+    check(mlfq.timeSlice(away, 100) == 100, "mlfq boost: an unqueued process is back at level 0");
+    check(mlfq.dequeue() == top, "mlfq boost: spliced levels follow level 0");
+    check(mlfq.remove(low), "mlfq boost: a spliced process can be removed");
+    check(mlfq.size() == 0, "mlfq boost: queue empty after removal");
+}
+
+} // namespace
+
+int main() {
+    demotesAfterFullAllotment();
+    boostReturnsEveryoneToTop();
+    return finish("mlfq_policy_test");
+}
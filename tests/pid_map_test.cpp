@@ -0,0 +1,58 @@
+// PidMap: insert/overwrite, backward-shift erase, growth
+#include "check.h"
+#include "pid_map.h"
+
+#include <unordered_map>
+
+namespace {
+
+void insertFindOverwrite() {
+    PidMap<int> map(4);
+    check(map.empty() && map.find(1) == nullptr, "pid map: starts empty");
+    map.insert(1, 10);
+    map.insert(2, 20);
+    map.insert(1, 11);
+    check(map.size() == 2, "pid map: overwrite keeps the size");
+    check(map.find(1) && *map.find(1) == 11, "pid map: overwrite replaces the value");
+    check(map.find(2) && *map.find(2) == 20, "pid map: second key found");
+    check(map.find(3) == nullptr, "pid map: missing key");
+    check(!map.erase(3), "pid map: erasing a missing key fails");
+    check(map.erase(1) && map.find(1) == nullptr, "pid map: erased key gone");
+    check(map.find(2) && map.size() == 1, "pid map: other key survives");
+    map.clear();
+    check(map.empty() && map.find(2) == nullptr, "pid map: clear empties");
+}
+
+// Erasing from the middle of probe runs must not hide the keys after the hole
+void eraseKeepsProbeRuns() {
+    PidMap<int> map(16);
+    std::unordered_map<int, int> reference;
+    for (int pid = 1; pid <= 2000; ++pid) {
+        map.insert(pid, pid * 3);
+        reference[pid] = pid * 3;
+    }
+    for (int pid = 1; pid <= 2000; pid += 3) {
+        map.erase(pid);
+        reference.erase(pid);
+    }
+    for (int pid = 5000; pid < 5200; ++pid) {
+        map.insert(pid, -pid);
+        reference[pid] = -pid;
+    }
+    check(map.size() == reference.size(), "pid map: size matches after churn");
+    bool allFound = true;
+    for (int pid = 1; pid < 5200; ++pid) {
+        auto it = reference.find(pid);
+        const int* value = map.find(pid);
+        if (it == reference.end() ? value != nullptr : (!value || *value != it->second)) allFound = false;
+    }
+    check(allFound, "pid map: every key resolves as in the reference map");
+}
+
+} // namespace
+
+int main() {
+    insertFindOverwrite();
+    eraseKeepsProbeRuns();
+    return finish("pid_map_test");
+}
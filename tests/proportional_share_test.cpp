@@ -0,0 +1,119 @@
+// FenwickTree, StridePolicy and LotteryPolicy: ticket lookups and CPU shares
+#include "check.h"
+#include "fenwick_tree.h"
+#include "policies.h"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+void fenwickFindMatchesScan() {
+    FenwickTree tree;
+    std::vector<long long> weights(200, 0);
+    std::mt19937 rng(3);
+    for (int i = 0; i < 2000; ++i) {
+        size_t index = rng() % weights.size(); // grows past the initial 16 slots
+        long long delta = static_cast<long long>(rng() % 50);
+        if (weights[index] > 0 && rng() % 3 == 0) delta = -weights[index]; // some drop to zero
+        tree.add(index, delta);
+        weights[index] += delta;
+    }
+    long long total = 0;
+    bool weightsMatch = true;
+    for (size_t i = 0; i < weights.size(); ++i) {
+        total += weights[i];
+        if (tree.weight(i) != weights[i]) weightsMatch = false;
+    }
+    check(weightsMatch && tree.total() == total, "fenwick: weights and total tracked");
+    check(tree.size() >= weights.size() && tree.weight(100000) == 0, "fenwick: grown, out of range reads zero");
+
+    bool found = true;
+    size_t index = 0;
+    long long prefix = 0;
+    for (long long target = 0; target < total; ++target) {
+        while (prefix + weights[index] <= target) prefix += weights[index++]; // skips zero weights
+        if (tree.find(target) != index) found = false;
+    }
+    check(found, "fenwick: find agrees with a linear scan for every target");
+}
+
+// Stride is deterministic: over whole rounds CPU time matches the tickets
+void strideSharesFollowTickets() {
+    ProcessTable table;
+    StridePolicy stride(table, PolicyOptions());
+    ProcessHandle procs[3] = {addReady(table, 1, 3, 1 << 30, 0),  // 2501 tickets
+                              addReady(table, 2, 5, 1 << 30, 0),  // 1024
+                              addReady(table, 3, 7, 1 << 30, 0)}; // 423
+    long long ran[3] = {0, 0, 0};
+    for (ProcessHandle h : procs) stride.enqueue(h);
+    for (int i = 0; i < 20000; ++i) {
+        ProcessHandle h = stride.dequeue();
+        stride.charge(h, 1);
+        ran[h] += 1;
+        stride.enqueue(h);
+    }
+    // Shares follow 1 / stride, the ticket ratio up to the integer stride's rounding
+    const int tickets[3] = {2501, 1024, 423};
+    double inverseSum = 0;
+    for (int t : tickets) inverseSum += 1.0 / (StridePolicy::STRIDE1 / t);
+    bool exact = true;
+    for (int i = 0; i < 3; ++i) {
+        double expected = 20000.0 / (StridePolicy::STRIDE1 / tickets[i]) / inverseSum;
+        if (ran[i] < expected - 1 || ran[i] > expected + 1) exact = false;
+    }
+    check(exact, "stride: CPU time within a slice of the stride ratio");
+
+    // A process joining later starts at the global pass, with no back credit
+    ProcessHandle late = addReady(table, 4, 5, 1 << 30, 0);
+    ProcessHandle top = stride.dequeue();
+    stride.enqueue(top);
+    stride.enqueue(late);
+    check(table.vruntime(late) >= table.vruntime(top), "stride: a newcomer starts no lower than the global pass");
+    check(stride.remove(late) && !stride.remove(late), "stride: remove once");
+    check(stride.size() == 3, "stride: three queued");
+}
+
+void lotteryDrawsByTickets() {
+    PolicyOptions options;
+    options.seed = 42;
+    ProcessTable table;
+    LotteryPolicy lottery(table, options);
+    LotteryPolicy replay(table, options);
+    ProcessHandle procs[2] = {addReady(table, 1, 0, 1 << 30, 0),  // 9548 tickets
+                              addReady(table, 2, 5, 1 << 30, 0)}; // 1024
+    for (ProcessHandle h : procs) {
+        lottery.enqueue(h);
+        lottery.enqueue(h);
+        replay.enqueue(h);
+    }
+    check(lottery.size() == 2, "lottery: double enqueue ignored");
+    check(lottery.preemptAtSliceEnd(procs[0]), "lottery: a queued process forces a new draw");
+
+    long long wins[2] = {0, 0};
+    bool reproducible = true;
+    for (int i = 0; i < 20000; ++i) {
+        ProcessHandle h = lottery.dequeue();
+        if (replay.dequeue() != h) reproducible = false;
+        wins[h]++;
+        lottery.enqueue(h);
+        replay.enqueue(h);
+    }
+    check(reproducible, "lottery: the same seed draws the same winners");
+    double share = wins[0] / 20000.0;
+    double expected = 9548.0 / (9548 + 1024);
+    check(share > expected - 0.02 && share < expected + 0.02, "lottery: wins follow the tickets");
+
+    check(lottery.remove(procs[0]) && !lottery.remove(procs[0]), "lottery: remove once");
+    check(lottery.dequeue() == procs[1], "lottery: the only ticket holder wins");
+    check(lottery.dequeue() == INVALID_PROCESS && !lottery.preemptAtSliceEnd(procs[1]), "lottery: empty");
+}
+
+} // namespace
+
+int main() {
+    fenwickFindMatchesScan();
+    strideSharesFollowTickets();
+    lotteryDrawsByTickets();
+    return finish("proportional_share_test");
+}
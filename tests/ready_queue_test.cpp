@@ -0,0 +1,79 @@
+// ReadyQueue: the binary heap and the priority buckets select in the same order
+#include "check.h"
+#include "ready_queue.h"
+#include <random>
+#include <vector>
+
+namespace {
+
+// Replays one random sequence of enqueues (ready times out of order, as timer
+// wake-ups produce them), removals and dequeues against both queue types
+void bothTypesAgree(uint64_t seed) {
+    ProcessTable table;
+    ReadyQueue heap(table, ReadyQueueType::BINARY_HEAP);
+    ReadyQueue buckets(table, ReadyQueueType::PRIORITY_BUCKETS);
+    heap.setAgingFactor(1);
+    buckets.setAgingFactor(1);
+
+    std::mt19937_64 rng(seed);
+    std::vector<ProcessHandle> queued;
+    long long now = 0;
+    int pid = 1;
+    bool same = true;
+    for (int step = 0; step < 5000; ++step) {
+        now += rng() % 50;
+        int action = static_cast<int>(rng() % 10);
+        if (action < 5) {
+            long long readyAt = now - static_cast<long long>(rng() % 3000); // a wake-up timestamped in the past
+            ProcessHandle h = addReady(table, pid++, static_cast<int>(rng() % DEFAULT_PRIORITY_LEVELS), 100, readyAt);
+            heap.enqueue(h);
+            buckets.enqueue(h);
+            queued.push_back(h);
+        } else if (action < 6 && !queued.empty()) {
+            size_t victim = rng() % queued.size();
+            bool fromHeap = heap.remove(queued[victim]);
+            bool fromBuckets = buckets.remove(queued[victim]);
+            same = same && fromHeap && fromBuckets;
+            queued.erase(queued.begin() + victim);
+        } else {
+            ProcessHandle fromHeap = heap.dequeue();
+            ProcessHandle fromBuckets = buckets.dequeue();
+            same = same && fromHeap == fromBuckets;
+            for (size_t i = 0; i < queued.size(); ++i) {
+                if (queued[i] == fromHeap) {
+                    queued.erase(queued.begin() + i);
+                    break;
+                }
+            }
+        }
+        same = same && heap.size() == buckets.size();
+    }
+    while (!heap.empty()) {
+        ProcessHandle fromHeap = heap.dequeue();
+        same = same && fromHeap == buckets.dequeue();
+    }
+    check(same, "ready queue: heap and buckets select the same process at every step");
+    check(buckets.empty(), "ready queue: both drained");
+}
+
+void agingOutranksHigherLevels() {
+    ProcessTable table;
+    for (ReadyQueueType type : {ReadyQueueType::BINARY_HEAP, ReadyQueueType::PRIORITY_BUCKETS}) {
+        ReadyQueue queue(table, type);
+        queue.setAgingFactor(1);
+        ProcessHandle old = addReady(table, static_cast<int>(table.size()) + 1, 9, 100, 0);
+        ProcessHandle fresh = addReady(table, static_cast<int>(table.size()) + 1, 2, 100, 8000);
+        queue.enqueue(fresh);
+        queue.enqueue(old);
+        check(queue.peek() == old, "ready queue: 8 s of aging lifts priority 9 above a fresh 2");
+        check(queue.contains(fresh) && queue.size() == 2, "ready queue: contains and size");
+    }
+}
+
+} // namespace
+
+int main() {
+    for (uint64_t seed = 1; seed <= 5; ++seed) bothTypesAgree(seed);
+    agingOutranksHigherLevels();
+    return finish("ready_queue_test");
+}
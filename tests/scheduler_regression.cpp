@@ -0,0 +1,137 @@
+// Regression checks for scheduler bugs found in review; exits non-zero on failure
+#include "check.h"
+#include "scheduler.h"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+void sleepMs(int ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+// Leaving CFS once processes have accumulated vruntime used to spin forever
+// under the scheduler lock: the reset zeroed the keys the old tree was sorted by
+void switchAwayFromCfs() {
+    Scheduler scheduler(ReadyQueueType::PRIORITY_BUCKETS, 5, 1);
+    scheduler.setTimeQuantum(10);
+    scheduler.setPolicy(SchedulingPolicyType::CFS);
+    for (int i = 0; i < 4; ++i) scheduler.createProcess("cfs", 5, 5000);
+    scheduler.start();
+    sleepMs(200);
+    scheduler.pause();
+
+    scheduler.setPolicy(SchedulingPolicyType::FCFS);
+    SchedulerStats stats = scheduler.getStats();
+    check(scheduler.getPolicy() == SchedulingPolicyType::FCFS, "CFS -> FCFS: policy switched");
+    check(stats.readyProcesses + stats.runningProcesses + stats.waitingProcesses == 4, "CFS -> FCFS: all processes kept");
+    scheduler.stop();
+}
+
+// Blocking the running process and unblocking it within the same slice used to
+// queue it while it was still its CPU's current process; an idle CPU then stole
+// it and the process ran on two CPUs at once
+void unblockWithinSlice() {
+    Scheduler scheduler(ReadyQueueType::PRIORITY_BUCKETS, 5, 2);
+    scheduler.setTimeQuantum(200);
+    int pid = scheduler.createProcess("long", 5, 5000);
+    scheduler.start();
+    sleepMs(50);
+    scheduler.blockProcess(pid);
+    scheduler.unblockProcess(pid);
+
+    bool single = true;
+    for (int i = 0; i < 20; ++i) {
+        sleepMs(15);
+        int onCpu = 0;
+        for (const CpuStats& cpu : scheduler.getStats().cpus) {
+            if (cpu.currentPid == pid) onCpu++;
+        }
+        single = single && onCpu <= 1;
+    }
+    scheduler.stop();
+    check(single, "unblock within the slice: process on one CPU at a time");
+}
+
+// Every create before start() used to rebuild and sort the whole process list
+void createWhileStopped() {
+    const int count = 20000;
+    Scheduler scheduler;
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) scheduler.createProcess("p", i % 11, 100);
+    ProcessSnapshotView snapshot = scheduler.getProcessSnapshot();
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    std::printf("createWhileStopped: %d creates in %lld ms\n", count,
+                static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()));
+
+    check(snapshot->processes.size() == static_cast<size_t>(count), "stopped: the snapshot lists every process");
+    check(snapshot->epoch < static_cast<uint64_t>(count / 10), "stopped: the list is not rebuilt per create");
+}
+
+// The shared histograms used to be rebuilt on every control call while stopped
+void histogramsWhileStopped() {
+    const int count = 2000;
+    Scheduler scheduler;
+    std::vector<std::shared_ptr<const StatsHistograms>> seen; // kept alive, so no address is reused
+    scheduler.setStatsCallback([&seen](const SchedulerStats& stats) {
+        if (seen.empty() || seen.back() != stats.histograms) seen.push_back(stats.histograms);
+    });
+    std::vector<int> pids;
+    for (int i = 0; i < count; ++i) pids.push_back(scheduler.createProcess("p", 5, 100));
+    for (int pid : pids) scheduler.terminateProcess(pid);
+
+    check(seen.size() < static_cast<size_t>(count / 10), "stopped: histograms are not rebuilt per change");
+    SchedulerStats stats = scheduler.getStats();
+    check(stats.histograms->latency.turnaround.count() == count, "stopped: getStats() has current histograms");
+}
+
+// The process list used to keep only the last 256 terminated processes
+void retiredHistoryKept() {
+    const int count = 600;
+    Scheduler scheduler;
+    std::vector<int> pids;
+    for (int i = 0; i < count; ++i) pids.push_back(scheduler.createProcess("p", 5, 100));
+    for (int pid : pids) scheduler.terminateProcess(pid);
+    check(scheduler.getProcessSnapshot()->processes.size() == static_cast<size_t>(count),
+          "history: every terminated process is listed by default");
+
+    scheduler.setRetiredHistoryLimit(100);
+    ProcessSnapshotView snapshot = scheduler.getProcessSnapshot();
+    check(snapshot->processes.size() == 100 && snapshot->processes.front().getPid() == pids[count - 100],
+          "history: a limit keeps the most recent");
+    check(scheduler.getStats().terminatedProcesses == count, "history: the counts still cover every process");
+}
+
+// A task submitted in SIMULATED mode used to be retired without ever running
+void taskOutsideTaskMode() {
+    Scheduler scheduler;
+    bool ran = false;
+    auto task = [&ran](TaskContext&) {
+        ran = true;
+        return TaskStatus::DONE;
+    };
+    check(scheduler.submitTask("task", 5, task) == -1, "tasks: refused in SIMULATED mode");
+    check(scheduler.getStats().totalProcesses == 0, "tasks: a refused task leaves no process");
+
+    scheduler.setExecutionMode(ExecutionMode::TASKS);
+    check(scheduler.submitTask("task", 5, task) > 0, "tasks: accepted in TASKS mode");
+    scheduler.setExecutionMode(ExecutionMode::SIMULATED);
+    check(scheduler.getExecutionMode() == ExecutionMode::TASKS, "tasks: mode kept while a task is pending");
+    scheduler.start();
+    for (int i = 0; i < 100 && scheduler.getStats().terminatedProcesses == 0; ++i) sleepMs(5);
+    scheduler.stop();
+    check(ran, "tasks: the task ran on a worker");
+    scheduler.setExecutionMode(ExecutionMode::SIMULATED);
+    check(scheduler.getExecutionMode() == ExecutionMode::SIMULATED, "tasks: mode switches once tasks finish");
+}
+
+} // namespace
+
+int main() {
+    switchAwayFromCfs();
+    unblockWithinSlice();
+    createWhileStopped();
+    histogramsWhileStopped();
+    retiredHistoryKept();
+    taskOutsideTaskMode();
+    return finish("scheduler_regression");
+}
@@ -0,0 +1,108 @@
+// TimerWheel: expiry order across levels, cancel, re-arming from callbacks
+#include "check.h"
+#include "timer_wheel.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+void firesInExpiryOrder() {
+    TimerWheel<int> wheel(100);
+    // One timer per level, one past the 64^4 ms horizon and one already due
+    wheel.schedule(100 + 20000000, 5);
+    wheel.schedule(100 + 300000, 4);
+    wheel.schedule(100 + 5000, 3);
+    wheel.schedule(100 + 70, 2);
+    wheel.schedule(100 + 3, 1);
+    wheel.schedule(50, 0);
+    check(wheel.size() == 6, "timer wheel: six pending");
+    check(wheel.nextExpiryBound() == 101, "timer wheel: overdue timer bounds the next expiry");
+
+    std::vector<std::pair<int, long long>> fired;
+    auto record = [&](int value, long long expires) { fired.emplace_back(value, expires); };
+    wheel.advance(100 + 5000, record);
+    check(fired.size() == 4, "timer wheel: four due by +5000");
+    check(wheel.now() == 5100, "timer wheel: advanced to the requested tick");
+    wheel.advance(100 + 20000000, record);
+    check(fired.size() == 6 && wheel.empty(), "timer wheel: all fired by the horizon timer");
+
+    bool ordered = true;
+    for (size_t i = 0; i < fired.size(); ++i) {
+        if (fired[i].first != static_cast<int>(i)) ordered = false;
+    }
+    check(ordered, "timer wheel: fired in expiry order");
+    check(fired[0].second == 101, "timer wheel: overdue timer fires on the next tick");
+    check(fired[5].second == 100 + 20000000, "timer wheel: horizon timer keeps its expiry");
+}
+
+void cancelAndRearm() {
+    TimerWheel<int> wheel;
+    auto a = wheel.schedule(10, 1);
+    wheel.schedule(10, 2);
+    check(wheel.cancel(a), "timer wheel: cancel pending");
+    check(!wheel.cancel(a), "timer wheel: cancel twice fails");
+    check(!wheel.cancel(TimerWheel<int>::INVALID_TIMER), "timer wheel: cancel invalid fails");
+
+    std::vector<int> fired;
+    wheel.advance(100, [&](int value, long long expires) {
+        fired.push_back(value);
+        if (value == 2) wheel.schedule(expires + 5, 3); // re-armed inside the callback
+    });
+    check(fired.size() == 2 && fired[0] == 2 && fired[1] == 3, "timer wheel: cancelled skipped, re-armed fires");
+    check(wheel.empty() && wheel.nextExpiryBound() == -1, "timer wheel: drained");
+}
+
+// Random schedules and cancels against a sorted reference, advancing in steps
+void matchesReference() {
+    std::mt19937 rng(7);
+    TimerWheel<int> wheel;
+    std::vector<long long> expiry;
+    std::vector<TimerWheel<int>::TimerId> ids;
+    std::vector<bool> live;
+    for (int i = 0; i < 3000; ++i) {
+        long long at = static_cast<long long>(rng() % 400000) + 1;
+        expiry.push_back(at);
+        ids.push_back(wheel.schedule(at, i));
+        live.push_back(true);
+    }
+    for (int i = 0; i < 3000; i += 7) {
+        wheel.cancel(ids[i]);
+        live[i] = false;
+    }
+
+    bool boundHolds = true;
+    bool inOrder = true;
+    bool onTime = true;
+    long long last = 0;
+    size_t count = 0;
+    for (long long now = 0; now < 400000 + 997; now += 997) {
+        long long bound = wheel.nextExpiryBound();
+        long long earliest = -1;
+        for (int i = 0; i < 3000; ++i) {
+            if (live[i] && (earliest < 0 || expiry[i] < earliest)) earliest = expiry[i];
+        }
+        if (earliest >= 0 && (bound < 0 || bound > earliest)) boundHolds = false;
+        wheel.advance(now, [&](int value, long long expires) {
+            if (expires < last) inOrder = false;
+            if (expires != expiry[value] || !live[value] || expires > now) onTime = false;
+            last = expires;
+            live[value] = false;
+            ++count;
+        });
+    }
+    check(boundHolds, "timer wheel: nextExpiryBound never passes the earliest expiry");
+    check(inOrder, "timer wheel: random timers fire in order");
+    check(onTime, "timer wheel: each live timer fires once at its expiry");
+    check(count == 3000 - 429 && wheel.empty(), "timer wheel: every uncancelled timer fired");
+}
+
+} // namespace
+
+int main() {
+    firesInExpiryOrder();
+    cancelAndRearm();
+    matchesReference();
+    return finish("timer_wheel_test");
+}